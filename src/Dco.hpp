@@ -5,6 +5,17 @@
 #include "BcpsConfig.h"
 #include "DcoConfig.hpp"
 
+// pthreads are used for asynchronous heuristics, parallel cut generation and
+// parallel parsing of CBF files.
+#if !defined(_MSC_VER)
+#define DISCO_THREADS
+#endif
+
+// input files are mapped to memory with mmap where POSIX is available.
+#if !defined(_MSC_VER)
+#define DISCO_MMAP
+#endif
+
 //! \page handle HomePage
 
 /*! \mainpage
@@ -290,7 +301,8 @@ enum DcoHeurStrategy {
 
 enum DcoHeurType {
   DcoHeurTypeNotSet = -1,
-  DcoHeurTypeRounding
+  DcoHeurTypeRounding,
+  DcoHeurTypeLocalSearch
 };
 
 enum DcoHotStartStrategy{
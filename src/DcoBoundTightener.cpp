@@ -0,0 +1,193 @@
+#include "DcoBoundTightener.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+/// Bounds larger than this in absolute value are infinite.
+static double const dcoBoundInfinity = 1e20;
+/// Implied bounds larger than this in absolute value are not used.
+static double const dcoBoundMaxBound = 1e8;
+/// Implied bounds of integer columns are rounded with this tolerance.
+static double const dcoBoundIntTol = 1e-6;
+/// Bounds crossing less than this, relative to their magnitude, are
+/// considered equal.
+static double const dcoBoundFeasTol = 1e-6;
+
+/// Distance of [lb, ub] to 0.
+static double dcoBoundDistance(double lb, double ub) {
+  if (lb>0.0) {
+    return lb;
+  }
+  if (ub<0.0) {
+    return -ub;
+  }
+  return 0.0;
+}
+
+DcoBoundTightener::DcoBoundTightener(int numCols, int const * isInteger):
+  lb_(NULL), ub_(NULL), isInteger_(isInteger, isInteger+numCols),
+  tol_(0.0), minChange_(0.0), minShrink_(0.0), relax_(0.0),
+  infeasible_(false), numTightened_(0) {
+}
+
+DcoBoundTightener::~DcoBoundTightener() {
+}
+
+void DcoBoundTightener::boundChanged(int col, bool lower, double oldBound,
+                                     double newBound) {
+}
+
+bool DcoBoundTightener::tightenLower(int col, double bound) {
+  if (fabs(bound)>dcoBoundMaxBound) {
+    return false;
+  }
+  double lb = lb_[col];
+  double ub = ub_[col];
+  if (isInteger_[col]) {
+    bound = ceil(bound-dcoBoundIntTol);
+  }
+  if (bound>ub+tol_+dcoBoundFeasTol*std::max(1.0, fabs(ub))) {
+    infeasible_ = true;
+    return false;
+  }
+  double min_change = dcoBoundIntTol;
+  if (!isInteger_[col]) {
+    bound -= relax_*std::max(1.0, fabs(bound));
+    double width = ub<dcoBoundInfinity ? ub-lb : std::max(1.0, fabs(lb));
+    min_change = std::max(minChange_*std::max(1.0, fabs(lb)),
+                          minShrink_*width);
+  }
+  if (lb>-dcoBoundInfinity and bound<=lb+min_change) {
+    return false;
+  }
+  if (bound>ub) {
+    // bounds cross within the tolerance
+    if (lb>=ub) {
+      return false;
+    }
+    bound = ub;
+  }
+  lb_[col] = bound;
+  numTightened_++;
+  boundChanged(col, true, lb, bound);
+  return true;
+}
+
+bool DcoBoundTightener::tightenUpper(int col, double bound) {
+  if (fabs(bound)>dcoBoundMaxBound) {
+    return false;
+  }
+  double lb = lb_[col];
+  double ub = ub_[col];
+  if (isInteger_[col]) {
+    bound = floor(bound+dcoBoundIntTol);
+  }
+  if (bound<lb-tol_-dcoBoundFeasTol*std::max(1.0, fabs(lb))) {
+    infeasible_ = true;
+    return false;
+  }
+  double min_change = dcoBoundIntTol;
+  if (!isInteger_[col]) {
+    bound += relax_*std::max(1.0, fabs(bound));
+    double width = lb>-dcoBoundInfinity ? ub-lb : std::max(1.0, fabs(ub));
+    min_change = std::max(minChange_*std::max(1.0, fabs(ub)),
+                          minShrink_*width);
+  }
+  if (ub<dcoBoundInfinity and bound>=ub-min_change) {
+    return false;
+  }
+  if (bound<lb) {
+    // bounds cross within the tolerance
+    if (ub<=lb) {
+      return false;
+    }
+    bound = lb;
+  }
+  ub_[col] = bound;
+  numTightened_++;
+  boundChanged(col, false, ub, bound);
+  return true;
+}
+
+void DcoBoundTightener::activity(int size, int const * ind,
+                                 double const * val, double & minAct,
+                                 int & minInf, double & maxAct,
+                                 int & maxInf) const {
+  minAct = 0.0;
+  maxAct = 0.0;
+  minInf = 0;
+  maxInf = 0;
+  for (int k=0; k<size; ++k) {
+    int col = ind[k];
+    double a = val[k];
+    // bound giving the smallest and the largest contribution
+    double low = a>0.0 ? lb_[col] : ub_[col];
+    double high = a>0.0 ? ub_[col] : lb_[col];
+    if (fabs(low)<dcoBoundInfinity) {
+      minAct += a*low;
+    }
+    else {
+      minInf++;
+    }
+    if (fabs(high)<dcoBoundInfinity) {
+      maxAct += a*high;
+    }
+    else {
+      maxInf++;
+    }
+  }
+}
+
+int DcoBoundTightener::tightenCone(int size, int const * members,
+                                   int type) {
+  int changes = 0;
+  int first = type;
+  // squared distance of the box of the members to the origin
+  double dist2 = 0.0;
+  for (int k=first; k<size; ++k) {
+    double d = dcoBoundDistance(lb_[members[k]], ub_[members[k]]);
+    dist2 += d*d;
+  }
+  // squared radius of the ball the members are in, negative if infinite.
+  double radius2 = -1.0;
+  if (first==1) {
+    // x_1 >= ||x_2n||
+    int lead = members[0];
+    changes += tightenLower(lead, sqrt(dist2));
+    if (ub_[lead]<dcoBoundInfinity) {
+      radius2 = ub_[lead]*ub_[lead];
+    }
+  }
+  else {
+    // 2x_1x_2 >= ||x_3n||^2
+    int lead1 = members[0];
+    int lead2 = members[1];
+    changes += tightenLower(lead1, 0.0);
+    changes += tightenLower(lead2, 0.0);
+    double ub1 = ub_[lead1];
+    double ub2 = ub_[lead2];
+    if (dist2>0.0 and ub2>0.0 and ub2<dcoBoundInfinity and !infeasible_) {
+      changes += tightenLower(lead1, dist2/(2.0*ub2));
+    }
+    if (dist2>0.0 and ub1>0.0 and ub1<dcoBoundInfinity and !infeasible_) {
+      changes += tightenLower(lead2, dist2/(2.0*ub1));
+    }
+    if (ub1<dcoBoundInfinity and ub2<dcoBoundInfinity) {
+      radius2 = 2.0*ub1*ub2;
+    }
+  }
+  if (radius2<0.0) {
+    return changes;
+  }
+  // |x_j| is at most the radius left by the other members.
+  for (int k=first; k<size and !infeasible_; ++k) {
+    int col = members[k];
+    double d = dcoBoundDistance(lb_[col], ub_[col]);
+    double bound = sqrt(std::max(radius2-dist2+d*d, 0.0));
+    changes += tightenLower(col, -bound);
+    if (!infeasible_) {
+      changes += tightenUpper(col, bound);
+    }
+  }
+  return changes;
+}
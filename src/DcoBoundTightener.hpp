@@ -0,0 +1,90 @@
+#ifndef DcoBoundTightener_hpp_
+#define DcoBoundTightener_hpp_
+
+#include <vector>
+
+/*!
+  DcoBoundTightener has the bound tightening steps shared by DcoPresolve
+  and DcoPropagator. It works on column bounds owned by the derived class
+  and gives
+
+  <ul>
+  <li> tightenLower() and tightenUpper(), which round bounds of integer
+       columns, detect crossing bounds and accept a bound only if it
+       changes enough. Continuous bounds can be relaxed by a small amount
+       so that numerical errors do not cut off feasible points.
+  <li> activity(), smallest and largest activities of a linear row.
+  <li> tightenCone(), bounds cone members by the leading variables and the
+       leading variables by the box of the members, for x_1 >= ||x_2n||
+       and 2x_1x_2 >= ||x_3n||^2.
+  </ul>
+
+  Derived classes set the bounds and the tolerances, boundChanged() is
+  called after every bound change.
+*/
+
+class DcoBoundTightener {
+protected:
+  /// Column bounds, owned by the derived class.
+  double * lb_;
+  double * ub_;
+  /// Nonzero for integer columns.
+  std::vector<int> isInteger_;
+  /// Absolute tolerance, bounds crossing less than this are not
+  /// infeasible. Default: 0.0
+  double tol_;
+  /// Bounds change only if they improve more than this, relative to the
+  /// magnitude of the bound. Default: 0.0
+  double minChange_;
+  /// Bounds of continuous columns change only if they shrink the domain by
+  /// more than this share of its width. Default: 0.0
+  double minShrink_;
+  /// Bounds of continuous columns are relaxed by this, relative to their
+  /// magnitude. Default: 0.0
+  double relax_;
+  /// True if bounds cross.
+  bool infeasible_;
+  /// Number of bound changes.
+  int numTightened_;
+
+  ///@name Bound changes
+  /// Tighten a bound of col to bound, returns true if it changes.
+  /// infeasible_ is set if bounds cross.
+  //@{
+  bool tightenLower(int col, double bound);
+  bool tightenUpper(int col, double bound);
+  //@}
+  /// Called after the lower or the upper bound of col changes from
+  /// oldBound to newBound.
+  virtual void boundChanged(int col, bool lower, double oldBound,
+                            double newBound);
+  /// Compute smallest and largest activity of the row with size entries
+  /// ind and val, number of infinite contributions are counted separately.
+  void activity(int size, int const * ind, double const * val,
+                double & minAct, int & minInf, double & maxAct,
+                int & maxInf) const;
+  /// Tighten bounds implied by the cone with size members, type is 1 for
+  /// Lorentz and 2 for rotated Lorentz cones. Returns the number of bound
+  /// changes.
+  int tightenCone(int size, int const * members, int type);
+public:
+  ///@name Constructors and Destructor
+  //@{
+  /// Copy integrality of numCols columns, bounds are set by the derived
+  /// class.
+  DcoBoundTightener(int numCols, int const * isInteger);
+  /// Destructor.
+  virtual ~DcoBoundTightener();
+  //@}
+  /// Get number of bound changes.
+  int numTightened() const { return numTightened_; }
+private:
+  /// Disable default constructor.
+  DcoBoundTightener();
+  /// Disable copy constructor.
+  DcoBoundTightener(DcoBoundTightener const & other);
+  /// Disable copy assignment operator.
+  DcoBoundTightener & operator=(DcoBoundTightener const & rhs);
+};
+
+#endif
@@ -1,160 +1,724 @@
 #include "DcoCbfIO.hpp"
+#include "DcoMappedFile.hpp"
 #include "Dco.hpp"
 #include <CoinPackedMatrix.hpp>
 #include <CoinFinite.hpp>
+#include <CoinHelperFunctions.hpp>
 
 #include <iostream>
-#include <sstream>
-#include <fstream>
-#include <iomanip>
 #include <cstdlib>
 #include <cstring>
-#include <ctime>
+#include <climits>
 #include <vector>
+#include <string>
 #include <exception>
 
+#if defined(DISCO_THREADS)
+#include <pthread.h>
+#endif
+
+// strtod_l converts in a given locale, it is available with POSIX 2008
+// locales. Elsewhere a stream in the classic locale is used.
+#if defined(__GLIBC__) or defined(__APPLE__)
+#define DISCO_CBF_STRTOD_L
+#include <locale.h>
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+#else
+#include <sstream>
+#include <locale>
+#endif
+
+/// Powers of 10 that are exact in double precision.
+static double const dcoCbfPow10[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+  1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+/// Largest exponent in dcoCbfPow10.
+static int const dcoCbfMaxPow10 = 22;
+/// Mantissas with more significant digits than this may not be exact in
+/// double precision, such numbers are parsed with dcoCbfStrtod().
+static int const dcoCbfMaxDigits = 15;
+
+#if defined(DISCO_CBF_STRTOD_L)
+/// C locale used by strtod_l, (locale_t)0 if it can not be created.
+/// DcoCbfIO::readCbf() creates it before parsing threads start.
+static locale_t dcoCbfCLocale() {
+  static locale_t c_locale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+  return c_locale;
+}
+#endif
+
+/// strtod in the C locale whatever the global locale is. str is null
+/// terminated, end is set to the first character not converted.
+static double dcoCbfStrtod(char const * str, char const *& end) {
+#if defined(DISCO_CBF_STRTOD_L)
+  char * parsed_end;
+  double value;
+  if (dcoCbfCLocale()!=(locale_t)0) {
+    value = strtod_l(str, &parsed_end, dcoCbfCLocale());
+  }
+  else {
+    value = strtod(str, &parsed_end);
+  }
+  end = parsed_end;
+  return value;
+#else
+  std::istringstream in(str);
+  in.imbue(std::locale::classic());
+  double value = 0.0;
+  in >> value;
+  if (in.fail()) {
+    end = str;
+  }
+  else if (in.eof()) {
+    end = str + strlen(str);
+  }
+  else {
+    end = str + static_cast<int>(in.tellg());
+  }
+  return value;
+#endif
+}
+
+static bool dcoCbfIsSpace(char c) {
+  return c==' ' or c=='\t' or c=='\r' or c=='\n' or c=='\v' or c=='\f';
+}
+
+/// Skip blanks, line ends and comment lines starting with #.
+static char const * dcoCbfSkipSpace(char const * p, char const * end) {
+  while (p<end) {
+    if (dcoCbfIsSpace(*p)) {
+      ++p;
+    }
+    else if (*p=='#') {
+      char const * eol =
+        static_cast<char const *>(memchr(p, '\n', end-p));
+      p = eol ? eol+1 : end;
+    }
+    else {
+      break;
+    }
+  }
+  return p;
+}
+
+/// Parse an integer token at p. Returns the end of the token, NULL if the
+/// token is not an integer.
+static char const * dcoCbfParseInt(char const * p, char const * end,
+                                   int & value) {
+  bool negative = false;
+  if (p<end and (*p=='-' or *p=='+')) {
+    negative = *p=='-';
+    ++p;
+  }
+  char const * digits = p;
+  int v = 0;
+  while (p<end and *p>='0' and *p<='9') {
+    int digit = *p-'0';
+    if (v>(INT_MAX-digit)/10) {
+      return NULL;
+    }
+    v = 10*v + digit;
+    ++p;
+  }
+  if (p==digits or (p<end and !dcoCbfIsSpace(*p))) {
+    return NULL;
+  }
+  value = negative ? -v : v;
+  return p;
+}
+
+/// Parse a floating point token at p. Returns the end of the token, NULL if
+/// the token is not a number. Numbers with at most dcoCbfMaxDigits
+/// significant digits and small exponents are converted with a single
+/// rounding, which gives the correctly rounded value. Others, including inf
+/// and nan, are handed to dcoCbfStrtod().
+static char const * dcoCbfParseDouble(char const * p, char const * end,
+                                      double & value) {
+  char const * start = p;
+  bool negative = false;
+  if (p<end and (*p=='-' or *p=='+')) {
+    negative = *p=='-';
+    ++p;
+  }
+  double mantissa = 0.0;
+  int num_digits = 0;
+  int exponent = 0;
+  bool any_digit = false;
+  bool exact = true;
+  for (; p<end and *p>='0' and *p<='9'; ++p) {
+    any_digit = true;
+    if (mantissa==0.0 and *p=='0') {
+      continue;
+    }
+    if (num_digits<dcoCbfMaxDigits) {
+      mantissa = 10.0*mantissa + (*p-'0');
+      num_digits++;
+    }
+    else {
+      exact = false;
+    }
+  }
+  if (p<end and *p=='.') {
+    for (++p; p<end and *p>='0' and *p<='9'; ++p) {
+      any_digit = true;
+      if (mantissa==0.0 and *p=='0') {
+        exponent--;
+        continue;
+      }
+      if (num_digits<dcoCbfMaxDigits) {
+        mantissa = 10.0*mantissa + (*p-'0');
+        num_digits++;
+        exponent--;
+      }
+      else {
+        exact = false;
+      }
+    }
+  }
+  if (any_digit and p<end and (*p=='e' or *p=='E')) {
+    int e;
+    char const * q = p+1;
+    bool negative_exp = false;
+    if (q<end and (*q=='-' or *q=='+')) {
+      negative_exp = *q=='-';
+      ++q;
+    }
+    char const * exp_digits = q;
+    for (e=0; q<end and *q>='0' and *q<='9' and e<100000; ++q) {
+      e = 10*e + (*q-'0');
+    }
+    if (q==exp_digits) {
+      return NULL;
+    }
+    exponent += negative_exp ? -e : e;
+    p = q;
+  }
+  if (any_digit and exact and (p==end or dcoCbfIsSpace(*p))) {
+    if (mantissa==0.0) {
+      value = negative ? -0.0 : 0.0;
+      return p;
+    }
+    if (exponent>=-dcoCbfMaxPow10 and exponent<=dcoCbfMaxPow10) {
+      value = (exponent<0) ? mantissa/dcoCbfPow10[-exponent] :
+        mantissa*dcoCbfPow10[exponent];
+      value = negative ? -value : value;
+      return p;
+    }
+  }
+  // slow path, contents are not null terminated, copy the token.
+  char buffer[128];
+  char const * token_end = start;
+  while (token_end<end and !dcoCbfIsSpace(*token_end)) {
+    ++token_end;
+  }
+  int len = token_end - start;
+  if (len==0 or len>=(int)sizeof(buffer)) {
+    return NULL;
+  }
+  memcpy(buffer, start, len);
+  buffer[len] = '\0';
+  char const * parsed_end;
+  value = dcoCbfStrtod(buffer, parsed_end);
+  if (parsed_end!=buffer+len) {
+    return NULL;
+  }
+  return token_end;
+}
+
+/// Print error message and throw.
+static void dcoCbfError(char const * message, char const * block) {
+  std::cerr << message << " " << block << std::endl;
+  throw std::exception();
+}
+
+/*!
+  Cursor on the contents of a CBF file. Keywords are read line by line,
+  numbers and words are read token by token as CBF allows any whitespace
+  between them.
+*/
+class DcoCbfScanner {
+  char const * p_;
+  char const * end_;
+public:
+  DcoCbfScanner(char const * begin, char const * end): p_(begin), end_(end) {}
+  char const * pos() const { return p_; }
+  char const * end() const { return end_; }
+  void setPos(char const * p) { p_ = p; }
+  /// Get the next line without end of line and trailing blanks. Returns
+  /// false at the end of the file.
+  bool nextLine(char const *& line, int & len) {
+    if (p_>=end_) {
+      return false;
+    }
+    char const * eol = static_cast<char const *>(memchr(p_, '\n', end_-p_));
+    if (eol==NULL) {
+      eol = end_;
+    }
+    line = p_;
+    len = eol - p_;
+    while (len>0 and dcoCbfIsSpace(line[len-1])) {
+      len--;
+    }
+    p_ = (eol<end_) ? eol+1 : end_;
+    return true;
+  }
+  bool readInt(int & value) {
+    p_ = dcoCbfSkipSpace(p_, end_);
+    char const * q = dcoCbfParseInt(p_, end_, value);
+    if (q) {
+      p_ = q;
+    }
+    return q!=NULL;
+  }
+  bool readDouble(double & value) {
+    p_ = dcoCbfSkipSpace(p_, end_);
+    char const * q = dcoCbfParseDouble(p_, end_, value);
+    if (q) {
+      p_ = q;
+    }
+    return q!=NULL;
+  }
+  bool readWord(std::string & word) {
+    p_ = dcoCbfSkipSpace(p_, end_);
+    char const * q = p_;
+    while (q<end_ and !dcoCbfIsSpace(*q)) {
+      ++q;
+    }
+    word.assign(p_, q);
+    p_ = q;
+    return !word.empty();
+  }
+  /// Read an entry of a coordinate block, numInd indices and a value.
+  bool readEntry(int numInd, int * ind, double & value) {
+    for (int k=0; k<numInd; ++k) {
+      if (!readInt(ind[k])) {
+        return false;
+      }
+    }
+    return readDouble(value);
+  }
+};
+
+static bool dcoCbfIsKeyword(char const * line, int len, char const * key) {
+  return len==(int)strlen(key) and !memcmp(line, key, len);
+}
+
+/// Latest CBF version supported.
+static int const dcoCbfMaxVersion = 2;
+
+/// Blocks of semidefinite and power cone problems, DisCO does not solve
+/// them.
+static char const * const dcoCbfUnsupported[] = {
+  "PSDVAR", "PSDCON", "OBJFCOORD", "FCOORD", "HCOORD", "DCOORD",
+  "POWCONES", "POW*CONES", "CHANGE", NULL };
+
+/// Blocks with fewer entries than this for each thread are parsed serially.
+static int const dcoCbfMinChunk = 50000;
+
+/// Entries [first, first+num) of a coordinate block, starting at line
+/// begin.
+struct DcoCbfChunk {
+  char const * begin;
+  char const * end;
+  int first;
+  int num;
+  /// Number of indices of an entry, at most 2.
+  int numInd;
+  /// ind[k][i] is the k-th index of entry i.
+  int * ind[2];
+  double * values;
+  /// Set if the chunk can not be parsed.
+  bool failed;
+};
+
+/// Parse a chunk. arg is a DcoCbfChunk.
+static void * dcoCbfChunkWorker(void * arg) {
+  DcoCbfChunk * chunk = reinterpret_cast<DcoCbfChunk*>(arg);
+  DcoCbfScanner scanner(chunk->begin, chunk->end);
+  int ind[2];
+  for (int i=chunk->first; i<chunk->first+chunk->num; ++i) {
+    if (!scanner.readEntry(chunk->numInd, ind, chunk->values[i])) {
+      chunk->failed = true;
+      break;
+    }
+    for (int k=0; k<chunk->numInd; ++k) {
+      chunk->ind[k][i] = ind[k];
+    }
+  }
+  return NULL;
+}
+
+/// Parse num entries of a coordinate block at the scanner position, each
+/// entry is numInd indices and a value. ind[k] and values should have room
+/// for num entries. Large blocks are split into line ranges parsed by
+/// numThreads threads, this requires one entry per line as the CBF format
+/// does.
+static void dcoCbfReadCoords(DcoCbfScanner & scanner, int num, int numInd,
+                             int ** ind, double * values, int numThreads,
+                             char const * block) {
+  int num_chunks = 1;
+#if defined(DISCO_THREADS)
+  num_chunks = CoinMax(1, CoinMin(numThreads, num/dcoCbfMinChunk));
+#endif
+  std::vector<DcoCbfChunk> chunks(num_chunks);
+  // find the line each chunk starts at and the end of the block.
+  char const * p = scanner.pos();
+  char const * end = scanner.end();
+  if (num_chunks>1) {
+    for (int i=0, c=0; i<num; ++i) {
+      p = dcoCbfSkipSpace(p, end);
+      if (p==end) {
+        dcoCbfError("Unexpected end of file in block", block);
+      }
+      if (c<num_chunks and i==(int)((double)c*num/num_chunks)) {
+        chunks[c].begin = p;
+        chunks[c].first = i;
+        c++;
+      }
+      char const * eol = static_cast<char const *>(memchr(p, '\n', end-p));
+      p = eol ? eol+1 : end;
+    }
+  }
+  else {
+    chunks[0].begin = p;
+    chunks[0].first = 0;
+  }
+  for (int c=0; c<num_chunks; ++c) {
+    chunks[c].end = end;
+    chunks[c].num = ((c+1<num_chunks) ? chunks[c+1].first : num) -
+      chunks[c].first;
+    chunks[c].numInd = numInd;
+    chunks[c].ind[0] = ind[0];
+    chunks[c].ind[1] = (numInd>1) ? ind[1] : NULL;
+    chunks[c].values = values;
+    chunks[c].failed = false;
+  }
+  if (num_chunks==1) {
+    // position after the last entry is not known, parse with the scanner.
+    for (int i=0; i<num; ++i) {
+      int entry[2];
+      if (!scanner.readEntry(numInd, entry, values[i])) {
+        dcoCbfError("Can not parse entries of block", block);
+      }
+      for (int k=0; k<numInd; ++k) {
+        ind[k][i] = entry[k];
+      }
+    }
+    return;
+  }
+#if defined(DISCO_THREADS)
+  // calling thread parses the first chunk.
+  std::vector<pthread_t> threads(num_chunks);
+  std::vector<bool> started(num_chunks, false);
+  for (int c=1; c<num_chunks; ++c) {
+    started[c] = !pthread_create(&threads[c], NULL, dcoCbfChunkWorker,
+                                 &chunks[c]);
+  }
+  dcoCbfChunkWorker(&chunks[0]);
+  for (int c=1; c<num_chunks; ++c) {
+    if (started[c]) {
+      pthread_join(threads[c], NULL);
+    }
+    else {
+      // could not create the thread, parse the chunk here.
+      dcoCbfChunkWorker(&chunks[c]);
+    }
+  }
+#endif
+  for (int c=0; c<num_chunks; ++c) {
+    if (chunks[c].failed) {
+      dcoCbfError("Can not parse entries of block", block);
+    }
+  }
+  scanner.setPos(p);
+}
+
+static CONES dcoCbfDomain(std::string const & dom) {
+  if (!dom.compare("F")) {
+    return FREE_RANGE;
+  }
+  else if (!dom.compare("L+")) {
+    return POSITIVE_ORT;
+  }
+  else if (!dom.compare("L-")) {
+    return NEGATIVE_ORT;
+  }
+  else if (!dom.compare("L=")) {
+    return FIXPOINT_ZERO;
+  }
+  else if (!dom.compare("Q")) {
+    return QUAD_CONE;
+  }
+  else if (!dom.compare("QR")) {
+    return RQUAD_CONE;
+  }
+  dcoCbfError("Unknown or unsupported domain", dom.c_str());
+  return FREE_RANGE;
+}
+
+/// Read size and domains of a VAR or CON block, sizes of the domains
+/// should add up to size.
+static void dcoCbfReadDomains(DcoCbfScanner & scanner, int & size,
+                              int & numDomains, CONES *& domains,
+                              int *& domainSize, char const * block) {
+  if (domains!=NULL) {
+    dcoCbfError("Duplicate block", block);
+  }
+  if (!scanner.readInt(size) or !scanner.readInt(numDomains) or
+      size<0 or numDomains<0) {
+    dcoCbfError("Can not parse block", block);
+  }
+  domains = new CONES[numDomains];
+  domainSize = new int[numDomains];
+  int total = 0;
+  for (int i=0; i<numDomains; ++i) {
+    std::string dom;
+    if (!scanner.readWord(dom) or !scanner.readInt(domainSize[i]) or
+        domainSize[i]<0) {
+      dcoCbfError("Can not parse block", block);
+    }
+    domains[i] = dcoCbfDomain(dom);
+    total += domainSize[i];
+  }
+  if (total!=size) {
+    dcoCbfError("Domain sizes do not add up in block", block);
+  }
+}
+
 DcoCbfIO::DcoCbfIO() {
+  version_ = 0;
+  sense_ = 1;
+  num_cols_ = 0;
+  num_col_domains_ = 0;
   col_domains_ = NULL;
   col_domain_size_ = NULL;
+  num_int_ = 0;
   integers_ = NULL;
+  num_rows_ = 0;
+  num_row_domains_ = 0;
   row_domains_ = NULL;
   row_domain_size_ = NULL;
   obj_coef_ = NULL;
-  row_coord_ = NULL;
-  col_coord_ = NULL;
+  obj_constant_ = 0.0;
+  num_lifted_ = 0;
+  num_nz_ = 0;
+  row_start_ = NULL;
+  col_index_ = NULL;
   coef_ = NULL;
   fixed_term_ = NULL;
+  num_threads_ = 1;
 }
 
 void DcoCbfIO::readCbf(char const * prob_file_path) {
-  // open file
-  std::ifstream prob_file;
-  prob_file.open(prob_file_path);
-  int sense;
-  std::string line;
-  while (std::getline(prob_file, line)) {
-    if (!line.compare("VER")) {
+  DcoMappedFile file;
+  if (!file.open(prob_file_path)) {
+    if (!file.error().empty()) {
+      std::string message = "Can not decompress file (" + file.error() + ")";
+      dcoCbfError(message.c_str(), prob_file_path);
+    }
+    dcoCbfError("Can not open file", prob_file_path);
+  }
+#if defined(DISCO_CBF_STRTOD_L)
+  // create the C locale before parsing threads use it.
+  dcoCbfCLocale();
+#endif
+  DcoCbfScanner scanner(file.begin(), file.end());
+  // ACOORD entries, matrix is built once all blocks are read.
+  std::vector<int> acoord_rows;
+  std::vector<int> acoord_cols;
+  std::vector<double> acoord_values;
+  char const * line;
+  int len;
+  while (scanner.nextLine(line, len)) {
+    if (len==0 or line[0]=='#') {
+      // empty line or comment
+      continue;
+    }
+    if (dcoCbfIsKeyword(line, len, "VER")) {
       // read VER block
-      prob_file >> version_;
-      if (version_ != 1) {
-        std::cerr << "Only version 1 is supported." << std::endl;
+      if (!scanner.readInt(version_)) {
+        dcoCbfError("Can not parse block", "VER");
+      }
+      if (version_<1 or version_>dcoCbfMaxVersion) {
+        std::cerr << "Only versions 1 to " << dcoCbfMaxVersion
+                  << " are supported." << std::endl;
         throw std::exception();
       }
     }
-    else if (!line.compare("OBJSENSE")) {
+    else if (dcoCbfIsKeyword(line, len, "OBJSENSE")) {
       // read objective sense
       std::string sense_str;
-      prob_file >> sense_str;
-      sense_ = !sense_str.compare("MAX") ? -1 : 1;
+      if (!scanner.readWord(sense_str)) {
+        dcoCbfError("Can not parse block", "OBJSENSE");
+      }
+      if (!sense_str.compare("MAX")) {
+        sense_ = -1;
+      }
+      else if (!sense_str.compare("MIN")) {
+        sense_ = 1;
+      }
+      else {
+        dcoCbfError("Unknown objective sense", sense_str.c_str());
+      }
     }
-    else if (!line.compare("VAR")) {
+    else if (dcoCbfIsKeyword(line, len, "VAR")) {
       // read var
-      prob_file >> num_cols_ >> num_col_domains_;
-      col_domains_ = new CONES[num_col_domains_];
-      col_domain_size_ = new int[num_col_domains_];
-      for (int i=0; i<num_col_domains_; ++i) {
-        std::string dom;
-        prob_file >> dom >> col_domain_size_[i];
-        if (!dom.compare("F")) {
-          col_domains_[i] = FREE_RANGE;
-        }
-        else if (!dom.compare("L+")) {
-          col_domains_[i] = POSITIVE_ORT;
-        }
-        else if (!dom.compare("L-")) {
-          col_domains_[i] = NEGATIVE_ORT;
-        }
-        else if (!dom.compare("L=")) {
-          col_domains_[i] = FIXPOINT_ZERO;
-        }
-        else if (!dom.compare("Q")) {
-          col_domains_[i] = QUAD_CONE;
-        }
-        else if (!dom.compare("QR")) {
-          col_domains_[i] = RQUAD_CONE;
-        }
-        else {
-          std::cerr << "Unknown domain!" << std::endl;
-          throw std::exception();
-        }
-      }
+      dcoCbfReadDomains(scanner, num_cols_, num_col_domains_, col_domains_,
+                        col_domain_size_, "VAR");
     }
-    else if (!line.compare("INT")) {
+    else if (dcoCbfIsKeyword(line, len, "INT")) {
       // read integrality info
-      prob_file >> num_int_;
+      if (!scanner.readInt(num_int_)) {
+        dcoCbfError("Can not parse block", "INT");
+      }
       integers_ = new int[num_int_];
       for (int i=0; i<num_int_; ++i) {
-        prob_file >> integers_[i];
+        if (!scanner.readInt(integers_[i]) or integers_[i]<0 or
+            integers_[i]>=num_cols_) {
+          dcoCbfError("Can not parse block", "INT");
+        }
       }
     }
-    else if (!line.compare("CON")) {
+    else if (dcoCbfIsKeyword(line, len, "CON")) {
       // read constraint info
-      prob_file >> num_rows_ >> num_row_domains_;
-      row_domains_ = new CONES[num_row_domains_];
-      row_domain_size_ = new int[num_row_domains_];
-      for (int i=0; i<num_row_domains_; ++i) {
-        std::string dom;
-        prob_file >> dom >> row_domain_size_[i];
-        if (!dom.compare("F")) {
-          row_domains_[i] = FREE_RANGE;
-        }
-        else if (!dom.compare("L+")) {
-          row_domains_[i] = POSITIVE_ORT;
-        }
-        else if (!dom.compare("L-")) {
-          row_domains_[i] = NEGATIVE_ORT;
-        }
-        else if (!dom.compare("L=")) {
-          row_domains_[i] = FIXPOINT_ZERO;
-        }
-        else if (!dom.compare("Q")) {
-          row_domains_[i] = QUAD_CONE;
-        }
-        else if (!dom.compare("QR")) {
-          row_domains_[i] = RQUAD_CONE;
-        }
-      }
+      dcoCbfReadDomains(scanner, num_rows_, num_row_domains_, row_domains_,
+                        row_domain_size_, "CON");
     }
-    else if (!line.compare("OBJACOORD")) {
+    else if (dcoCbfIsKeyword(line, len, "OBJACOORD")) {
       // read objective coef
       obj_coef_ = new double[num_cols_]();
       int num_coef;
-      prob_file >> num_coef;
+      if (!scanner.readInt(num_coef)) {
+        dcoCbfError("Can not parse block", "OBJACOORD");
+      }
+      std::vector<int> index(num_coef);
+      std::vector<double> value(num_coef);
+      int * ind[1] = { num_coef ? &index[0] : NULL };
+      dcoCbfReadCoords(scanner, num_coef, 1, ind,
+                       num_coef ? &value[0] : NULL, num_threads_,
+                       "OBJACOORD");
       for (int i=0; i<num_coef; ++i) {
-        int index;
-        double value;
-        prob_file >> index >> value;
-        obj_coef_[index] = value;
+        if (index[i]<0 or index[i]>=num_cols_) {
+          dcoCbfError("Index out of range in block", "OBJACOORD");
+        }
+        obj_coef_[index[i]] = value[i];
       }
     }
-    else if (!line.compare("ACOORD")) {
+    else if (dcoCbfIsKeyword(line, len, "OBJBCOORD")) {
+      // read objective constant
+      if (!scanner.readDouble(obj_constant_)) {
+        dcoCbfError("Can not parse block", "OBJBCOORD");
+      }
+    }
+    else if (dcoCbfIsKeyword(line, len, "ACOORD")) {
       // read constraint coefficient
-      prob_file >> num_nz_;
-      row_coord_ = new int[num_nz_];
-      col_coord_ = new int[num_nz_];
-      coef_ = new double[num_nz_];
-      for (int i=0; i<num_nz_; ++i) {
-        prob_file >> row_coord_[i]
-                  >> col_coord_[i]
-                  >> coef_[i];
+      int num_coef;
+      if (!scanner.readInt(num_coef)) {
+        dcoCbfError("Can not parse block", "ACOORD");
       }
+      acoord_rows.resize(num_coef);
+      acoord_cols.resize(num_coef);
+      acoord_values.resize(num_coef);
+      int * ind[2] = { num_coef ? &acoord_rows[0] : NULL,
+                       num_coef ? &acoord_cols[0] : NULL };
+      dcoCbfReadCoords(scanner, num_coef, 2, ind,
+                       num_coef ? &acoord_values[0] : NULL, num_threads_,
+                       "ACOORD");
     }
-    else if (!line.compare("BCOORD")) {
+    else if (dcoCbfIsKeyword(line, len, "BCOORD")) {
       // read constant term
       int nonzero_rhs;
       fixed_term_ = new double[num_rows_]();
-      prob_file >> nonzero_rhs;
+      if (!scanner.readInt(nonzero_rhs)) {
+        dcoCbfError("Can not parse block", "BCOORD");
+      }
+      std::vector<int> index(nonzero_rhs);
+      std::vector<double> value(nonzero_rhs);
+      int * ind[1] = { nonzero_rhs ? &index[0] : NULL };
+      dcoCbfReadCoords(scanner, nonzero_rhs, 1, ind,
+                       nonzero_rhs ? &value[0] : NULL, num_threads_,
+                       "BCOORD");
       for (int i=0; i<nonzero_rhs; ++i) {
-        int index;
-        double value;
-        prob_file >> index >> value;
-        fixed_term_[index] = value;
+        if (index[i]<0 or index[i]>=num_rows_) {
+          dcoCbfError("Index out of range in block", "BCOORD");
+        }
+        fixed_term_[index[i]] = value[i];
+      }
+    }
+    else {
+      std::string keyword(line, len);
+      for (int i=0; dcoCbfUnsupported[i]; ++i) {
+        if (!keyword.compare(dcoCbfUnsupported[i])) {
+          dcoCbfError("Unsupported block", keyword.c_str());
+        }
       }
+      dcoCbfError("Unknown keyword", keyword.c_str());
     }
   }
-  prob_file.close();
+  if (version_==0) {
+    dcoCbfError("Missing block", "VER");
+  }
+  // blocks are optional
+  if (obj_coef_==NULL) {
+    obj_coef_ = new double[num_cols_]();
+  }
+  if (fixed_term_==NULL) {
+    fixed_term_ = new double[num_rows_]();
+  }
+  int num_coef = acoord_values.size();
+  buildMatrix(num_coef, num_coef ? &acoord_rows[0] : NULL,
+              num_coef ? &acoord_cols[0] : NULL,
+              num_coef ? &acoord_values[0] : NULL);
 }
 
+// Rows are filled by counting sort, order of the entries within a row is
+// kept.
+void DcoCbfIO::buildMatrix(int num, int const * rows, int const * cols,
+                           double const * values) {
+  // lifted_col[i] is the lifted column of row i, -1 if row i is not conic.
+  // Lifted columns follow the problem columns in the order of the conic row
+  // domains, assignProblem() relies on this.
+  std::vector<int> lifted_col(num_rows_, -1);
+  num_lifted_ = 0;
+  for (int i=0, row_index=0; i<num_row_domains_; ++i) {
+    if (row_domains_[i]==QUAD_CONE or row_domains_[i]==RQUAD_CONE) {
+      for (int j=0; j<row_domain_size_[i]; ++j) {
+        lifted_col[row_index+j] = num_cols_ + num_lifted_++;
+      }
+    }
+    row_index += row_domain_size_[i];
+  }
+  row_start_ = new CoinBigIndex[num_rows_+1]();
+  for (int k=0; k<num; ++k) {
+    if (rows[k]<0 or rows[k]>=num_rows_ or cols[k]<0 or
+        cols[k]>=num_cols_) {
+      dcoCbfError("Index out of range in block", "ACOORD");
+    }
+    row_start_[rows[k]+1]++;
+  }
+  for (int i=0; i<num_rows_; ++i) {
+    row_start_[i+1] += row_start_[i] + (lifted_col[i]>=0 ? 1 : 0);
+  }
+  num_nz_ = row_start_[num_rows_];
+  col_index_ = new int[num_nz_];
+  coef_ = new double[num_nz_];
+  std::vector<CoinBigIndex> pos(row_start_, row_start_+num_rows_);
+  for (int k=0; k<num; ++k) {
+    CoinBigIndex p = pos[rows[k]]++;
+    col_index_[p] = cols[k];
+    coef_[p] = values[k];
+  }
+  // convert Ax + b in L
+  // to -y + Ax + b = 0 and y in L
+  for (int i=0; i<num_rows_; ++i) {
+    if (lifted_col[i]>=0) {
+      col_index_[pos[i]] = lifted_col[i];
+      coef_[pos[i]] = -1.0;
+    }
+  }
+}
 
 int DcoCbfIO::check_row_domains() const {
   for (int i=0; i<num_row_domains_; ++i) {
@@ -179,14 +743,17 @@ DcoCbfIO::~DcoCbfIO() {
   if (row_domain_size_) {
     delete[] row_domain_size_;
   }
+  if (integers_) {
+    delete[] integers_;
+  }
   if (obj_coef_) {
     delete[] obj_coef_;
   }
-  if (row_coord_) {
-    delete[] row_coord_;
+  if (row_start_) {
+    delete[] row_start_;
   }
-  if (col_coord_) {
-    delete[] col_coord_;
+  if (col_index_) {
+    delete[] col_index_;
   }
   if (coef_) {
     delete[] coef_;
@@ -197,215 +764,138 @@ DcoCbfIO::~DcoCbfIO() {
 }
 
 
-// get problem in following form, i.e.,
+// transfer problem in following form, i.e.,
 //
 // rowLB <= Ax <= rowUB
 // colLB <= x  <= colUB
 // x^i in L for i=1, ..., k
 //
 // this function is called after problem is read from file.
-void DcoCbfIO::getProblem(double *& colLB, double *& colUB,
-                double *& rowLB, double *& rowUB,
-                CoinPackedMatrix *& matrix,
-                int & numCones, int *& coneStart,
-                int *& coneMembers, int *& coneType) const {
-  // regular columns
-  int numCols = num_cols_;
-  // add columns from lifting, reduce row domains to column domains (Lorentz cones)
-  // convert ax + alpha in L
-  // to -y + ax + alpha = 0 and y in L
+void DcoCbfIO::assignProblem(double *& colLB, double *& colUB,
+                             double *& rowLB, double *& rowUB,
+                             CoinPackedMatrix *& matrix, double *& objCoef,
+                             int & numInteger, int *& integerCols,
+                             int & numCones, int *& coneStart,
+                             int *& coneMembers, int *& coneType) {
+  // regular columns and lifted columns of conic rows,
+  // -y + ax + alpha = 0 and y in L
+  int numCols = num_cols_ + num_lifted_;
+  // count cones, column domains first, lifted columns of row domains next.
+  numCones = 0;
+  int total_in_cone = 0;
+  for (int i=0; i<num_col_domains_; ++i) {
+    if (col_domains_[i]==QUAD_CONE or col_domains_[i]==RQUAD_CONE) {
+      numCones++;
+      total_in_cone += col_domain_size_[i];
+    }
+  }
   for (int i=0; i<num_row_domains_; ++i) {
     if (row_domains_[i]==QUAD_CONE or row_domains_[i]==RQUAD_CONE) {
-      numCols += row_domain_size_[i];
+      numCones++;
+      total_in_cone += row_domain_size_[i];
     }
   }
+  coneStart = new int[numCones+1];
+  coneType = new int[numCones];
+  coneMembers = new int[total_in_cone];
+  coneStart[0] = 0;
+  int cone = 0;
+  // no column bounds initially
   colLB = new double[numCols];
   colUB = new double[numCols];
-  std::vector<int*> cMembers;
-  std::vector<int> cType;
-  std::vector<int> cStart;
-  cStart.push_back(0);
-  // set upper and lower bounds to inf and -inf
-  // no column bounds initially
   std::fill_n(colLB, numCols, -getInfinity());
   std::fill_n(colUB, numCols, getInfinity());
   // iterate over col domains and set column bounds and get cone info
   int col_index = 0;
   for (int i=0; i<num_col_domains_; ++i) {
-    if (col_domains_[i] == FREE_RANGE) {
-      // free domain, do nothing
-    }
-    else if (col_domains_[i] == POSITIVE_ORT) {
-      // set lower bound of domain size many elements to 0
-      std::fill_n(colLB+col_index, col_domain_size_[i], 0.0);
-    }
-    else if (col_domains_[i] == NEGATIVE_ORT) {
-      // set upper bound of domain size many elements to 0
-      std::fill_n(colUB+col_index, col_domain_size_[i], 0.0);
-    }
-    else if (col_domains_[i] == FIXPOINT_ZERO) {
-      // set lower bound of domain size many elements to 0
-      std::fill_n(colLB+col_index, col_domain_size_[i], 0.0);
-      // set upper bound of domain size many elements to 0
-      std::fill_n(colUB+col_index, col_domain_size_[i], 0.0);
-    }
-    else if (col_domains_[i] == QUAD_CONE) {
-      // variables are in a lorentz cone. Add a conic constraint.
-      int * members = new int[col_domain_size_[i]];
-      for (int j=0; j<col_domain_size_[i]; ++j) members[j] = j+col_index;
-      cMembers.push_back(members);
-      cType.push_back(1);
-      cStart.push_back(cStart.back()+col_domain_size_[i]);
-      // leading variable is nonnegative.
-      colLB[members[0]] = 0.0;
-      members = 0;
-    }
-    else if (col_domains_[i] == RQUAD_CONE) {
-      // variables are in a lorentz cone. Add a conic constraint.
-      int * members = new int[col_domain_size_[i]];
-      for (int j=0; j<col_domain_size_[i]; ++j) members[j] = j+col_index;
-      cMembers.push_back(members);
-      cType.push_back(2);
-      cStart.push_back(cStart.back()+col_domain_size_[i]);
-      // leading variable is nonnegative.
-      colLB[members[0]] = 0.0;
-      colLB[members[1]] = 0.0;
-      members = 0;
-    }
-    col_index += col_domain_size_[i];
-  }
-
-  double * rhs = new double[num_rows_];
-  for(int i=0; i<num_rows_; ++i) {
-    rhs[i] = -fixed_term_[i];
+    int size = col_domain_size_[i];
+    if (col_domains_[i]==POSITIVE_ORT or col_domains_[i]==FIXPOINT_ZERO) {
+      std::fill_n(colLB+col_index, size, 0.0);
+    }
+    if (col_domains_[i]==NEGATIVE_ORT or col_domains_[i]==FIXPOINT_ZERO) {
+      std::fill_n(colUB+col_index, size, 0.0);
+    }
+    if (col_domains_[i]==QUAD_CONE or col_domains_[i]==RQUAD_CONE) {
+      addCone(col_domains_[i], col_index, size, colLB, cone, coneStart,
+              coneMembers, coneType);
+    }
+    col_index += size;
   }
-
-  // iterate over row domains and set column bounds and get cone info
-  rowLB = new double[num_rows_];
-  rowUB = new double[num_rows_];
-  // no row bounds initially
+  // linear rows are followed by conic rows, bounds of conic rows are 0 and
+  // infinity.
+  int numRows = num_rows_ + numCones;
+  rowLB = new double[numRows];
+  rowUB = new double[numRows];
   std::fill_n(rowLB, num_rows_, -getInfinity());
   std::fill_n(rowUB, num_rows_, getInfinity());
+  std::fill_n(rowLB+num_rows_, numCones, 0.0);
+  std::fill_n(rowUB+num_rows_, numCones, getInfinity());
   // iterate over row domains and set row bounds and get cone info
   for (int i=0, row_index=0; i<num_row_domains_; ++i) {
-    if (row_domains_[i]==FREE_RANGE) {
-      // free domain, do nothing
-    }
-    else if (row_domains_[i]==POSITIVE_ORT) {
-      // set lower bound of domain size many elements
-      std::copy(rhs+row_index, rhs+row_index+row_domain_size_[i],
-                rowLB+row_index);
-    }
-    else if (row_domains_[i]==NEGATIVE_ORT) {
-      // set upper bound of domain size many elements
-      std::copy(rhs+row_index, rhs+row_index+row_domain_size_[i],
-                rowUB+row_index);
-    }
-    else if (row_domains_[i]==FIXPOINT_ZERO) {
-      // set lower bound of domain size many elements
-      std::copy(rhs+row_index, rhs+row_index+row_domain_size_[i],
-                rowLB+row_index);
-      // set upper bound of domain size many elements
-      std::copy(rhs+row_index, rhs+row_index+row_domain_size_[i],
-                rowUB+row_index);
-    }
-    else if (row_domains_[i]==QUAD_CONE) {
-      // variables are in a lorentz cone. Add a conic constraint.
-      int * members = new int[row_domain_size_[i]];
-      for (int j=0; j<row_domain_size_[i]; ++j) members[j] = j+col_index;
-      cMembers.push_back(members);
-      cType.push_back(1);
-      cStart.push_back(cStart.back()+row_domain_size_[i]);
-      // leading row is nonnegative.
-      colLB[members[0]] = 0.0;
-      members = 0;
-      col_index += row_domain_size_[i];
-      // set rowlb and rowub to rhs
-      std::copy(rhs+row_index, rhs+row_index+row_domain_size_[i], rowLB+row_index);
-      std::copy(rhs+row_index, rhs+row_index+row_domain_size_[i], rowUB+row_index);
-    }
-    else if (row_domains_[i]==RQUAD_CONE) {
-      // variables are in a lorentz cone. Add a conic constraint.
-      int * members = new int[row_domain_size_[i]];
-      for (int j=0; j<row_domain_size_[i]; ++j) members[j] = j+col_index;
-      cMembers.push_back(members);
-      cType.push_back(2);
-      cStart.push_back(cStart.back()+row_domain_size_[i]);
-      // leading variable is nonnegative.
-      colLB[members[0]] = 0.0;
-      colLB[members[1]] = 0.0;
-      members = 0;
-      col_index += row_domain_size_[i];
-      // set rowlb and rowub to rhs
-      std::copy(rhs+row_index, rhs+row_index+row_domain_size_[i], rowLB+row_index);
-      std::copy(rhs+row_index, rhs+row_index+row_domain_size_[i], rowUB+row_index);
+    int size = row_domain_size_[i];
+    bool conic = row_domains_[i]==QUAD_CONE or row_domains_[i]==RQUAD_CONE;
+    for (int j=row_index; j<row_index+size; ++j) {
+      if (conic or row_domains_[i]==POSITIVE_ORT or
+          row_domains_[i]==FIXPOINT_ZERO) {
+        rowLB[j] = -fixed_term_[j];
+      }
+      if (conic or row_domains_[i]==NEGATIVE_ORT or
+          row_domains_[i]==FIXPOINT_ZERO) {
+        rowUB[j] = -fixed_term_[j];
+      }
     }
-    row_index += row_domain_size_[i];
+    if (conic) {
+      // lifted columns are in a lorentz cone.
+      addCone(row_domains_[i], col_index, size, colLB, cone, coneStart,
+              coneMembers, coneType);
+      col_index += size;
+    }
+    row_index += size;
   }
-
-  // compute cone info from cMembers and cType
-  numCones = cMembers.size();
-  coneStart = new int[numCones+1];
-  coneType = new int[numCones];
-  std::copy(cType.begin(), cType.end(), coneType);
-  std::copy(cStart.begin(), cStart.end(), coneStart);
-  int total_in_cone = 0;
-  for (int i=0; i<numCones; ++i) {
-    total_in_cone += coneStart[i+1] - coneStart[i];
+  // objective and integers, lifted columns are continuous and do not
+  // appear in the objective.
+  if (num_lifted_) {
+    objCoef = new double[numCols]();
+    CoinCopyN(obj_coef_, num_cols_, objCoef);
+    delete[] obj_coef_;
   }
-  coneMembers = new int[total_in_cone];
-  for (int i=0; i<numCones; ++i) {
-    int size = coneStart[i+1] - coneStart[i];
-    std::copy(cMembers[i], cMembers[i]+size, coneMembers+coneStart[i]);
+  else {
+    objCoef = obj_coef_;
   }
-
-  // get rows in CoinPackedMatrix format
-
-  matrix = new CoinPackedMatrix(0, row_coord_, col_coord_, coef_, num_nz_);
-  {
-    // convert Ax + b in L
-    // to -y + Ax + b = 0 and y in L
-    int numcols = 0;
-
-
-    // rows is always row_index, row_index+1, ...,
-    // row_index+row_domain_size[i]-1
-    std::vector<int> rows;
-
-    for (int i=0, row_index=0; i<num_row_domains_; ++i) {
-      if (row_domains_[i]==QUAD_CONE or row_domains_[i]==RQUAD_CONE) {
-        for (int j=0; j<row_domain_size_[i]; ++j)
-          rows.push_back(row_index+j);
-        numcols += row_domain_size_[i];
-      }
-      row_index += row_domain_size_[i];
-    }
-
-    if (numcols) {
-      // colstarts is always col_index, col_index+1, ...,
-      // col_index+row_domain_size[i]-1
-      std::vector<int> colstarts;
-      for (int j=0; j<numcols; ++j)
-        colstarts.push_back(j);
-      colstarts.push_back(numcols);
-
-      double * elements = new double[numcols];
-      std::fill_n(elements, numcols, -1.0);
-      // colstarts, rows
-      int * colstarts_arr = new int[numcols+1];
-      std::copy(colstarts.begin(), colstarts.end(), colstarts_arr);
-      int * rows_arr = new int[numcols];
-      std::copy(rows.begin(), rows.end(), rows_arr);
-      matrix->appendCols(numcols, colstarts_arr, rows_arr, elements);
-      delete[] rows_arr;
-      delete[] colstarts_arr;
-      delete[] elements;
-      colstarts.clear();
-    }
-    rows.clear();
+  obj_coef_ = NULL;
+  numInteger = num_int_;
+  integerCols = integers_ ? integers_ : new int[0];
+  integers_ = NULL;
+  // rows in CoinPackedMatrix format, lifted columns are in the row ordered
+  // matrix already.
+  int * length = new int[num_rows_];
+  for (int i=0; i<num_rows_; ++i) {
+    length[i] = row_start_[i+1] - row_start_[i];
   }
+  matrix = new CoinPackedMatrix();
+  // matrix takes ownership of the arrays
+  matrix->assignMatrix(false, numCols, num_rows_, num_nz_, coef_,
+                       col_index_, row_start_, length);
+  coef_ = NULL;
+  col_index_ = NULL;
+  row_start_ = NULL;
 }
 
+void DcoCbfIO::addCone(CONES domain, int first, int size, double * colLB,
+                       int & cone, int * coneStart, int * coneMembers,
+                       int * coneType) {
+  for (int j=0; j<size; ++j) {
+    coneMembers[coneStart[cone]+j] = first+j;
+  }
+  coneStart[cone+1] = coneStart[cone] + size;
+  coneType[cone] = (domain==QUAD_CONE) ? 1 : 2;
+  // leading variables are nonnegative.
+  colLB[first] = 0.0;
+  if (domain==RQUAD_CONE) {
+    colLB[first+1] = 0.0;
+  }
+  cone++;
+}
 
 double DcoCbfIO::getInfinity() const {
   return COIN_DBL_MAX;
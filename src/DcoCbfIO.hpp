@@ -1,6 +1,8 @@
 #ifndef DcoCbfIO_hpp_
 #define DcoCbfIO_hpp_
 
+#include <CoinTypes.hpp>
+
 class CoinPackedMatrix;
 
 enum CONES {
@@ -21,6 +23,23 @@ enum CONES {
 /*!
   DisCO's CBF (Conic Benchmark Format) reader.
 
+  Versions 1 and 2 are read for the conic subset of the format, i.e.,
+  linear and quadratic domains, integrality and the objective constant.
+  Semidefinite and power cone blocks, unknown keywords and unknown domains
+  are errors. DcoModel::writeCbf() writes files this class reads.
+
+  The file is mapped to memory and tokenized with a hand written number
+  parser. Numbers it can not convert exactly are converted with strtod_l
+  in the C locale, or with a stream in the classic locale where strtod_l
+  is not available, so numbers are read in the C locale regardless of the
+  global locale. Entries of large ACOORD, OBJACOORD and BCOORD blocks are
+  one per line, these blocks are split into line ranges that are parsed in
+  parallel, see setNumThreads().
+
+  Coefficient matrix is stored row ordered. Conic rows Ax + b in L are
+  written as -y + Ax + b = 0, y in L, where y are the lifted columns
+  appended after the problem columns. The -1 entry of the lifted column is
+  the last entry of its row.
  */
 
 class DcoCbfIO {
@@ -39,19 +58,35 @@ class DcoCbfIO {
   CONES * row_domains_;
   int * row_domain_size_;
   double * obj_coef_;
-  /// coefficient matrix number of nonzeros
+  /// objective constant, OBJBCOORD
+  double obj_constant_;
+  /// number of lifted columns, one for each row in a conic domain
+  int num_lifted_;
+  /// coefficient matrix number of nonzeros, including lifted columns
   int num_nz_;
-  /// coefficient matrix row coordinates
-  int * row_coord_;
-  /// coefficient matrix column coordinates
-  int * col_coord_;
+  /// row starts of coefficient matrix, num_rows_+1 entries
+  CoinBigIndex * row_start_;
+  /// column indices of coefficient matrix
+  int * col_index_;
   /// values of matrix coefficients
   double * coef_;
   double * fixed_term_;
+  /// number of threads used for parsing coordinate blocks
+  int num_threads_;
+  /// Build row ordered matrix from ACOORD entries and lifted columns.
+  void buildMatrix(int num, int const * rows, int const * cols,
+                   double const * values);
+  /// Add cone of given domain with members first, ..., first+size-1 as
+  /// cone number cone, set leading members nonnegative and increase cone.
+  void addCone(CONES domain, int first, int size, double * colLB,
+               int & cone, int * coneStart, int * coneMembers,
+               int * coneType);
 public:
   DcoCbfIO();
   ~DcoCbfIO();
   void readCbf(char const * cbf_file);
+  /// Set number of threads used for parsing coordinate blocks.
+  void setNumThreads(int numThreads) { num_threads_ = numThreads; }
   /// returns nonzero if rows are in quadratic or rotated quadratic domains
   int check_row_domains() const;
   /// get number of columns
@@ -60,14 +95,21 @@ public:
   int getNumRows() const { return num_rows_; }
   int objSense() const { return sense_; }
   double const * objCoef() const { return obj_coef_; }
+  /// get objective constant
+  double objConstant() const { return obj_constant_; }
   ///@name Getting integrality
   int getNumInteger() const { return num_int_; }
   int const * integerCols() const { return integers_; }
   //@}
   //@name Getting linear constraints
   //@{
-  int const * rowCoord() const { return row_coord_; }
-  int const * colCoord() const { return col_coord_; }
+  /// get number of coefficient matrix nonzeros, including lifted columns
+  int getNumElements() const { return num_nz_; }
+  /// get row starts of the row ordered coefficient matrix
+  CoinBigIndex const * rowStart() const { return row_start_; }
+  /// get column indices of the row ordered coefficient matrix
+  int const * colIndex() const { return col_index_; }
+  /// get values of the row ordered coefficient matrix
   double const * matCoef() const { return coef_; }
   //@}
   ///@name Getting domains
@@ -81,11 +123,16 @@ public:
   /// get type of row domains
   CONES const * rowDomains() const { return row_domains_; }
   //@}
-  void getProblem(double *& colLB, double *& colUB,
-                  double *& rowLB, double *& rowUB,
-                  CoinPackedMatrix *& matrix,
-                  int & numCones, int *& coneStart,
-                  int *& coneMembers, int *& coneType) const;
+  /// Transfer the problem to the caller in the form rowLB <= Ax <= rowUB,
+  /// colLB <= x <= colUB and cones. Conic row bounds, 0 and infinity,
+  /// follow the linear rows in rowLB and rowUB. Arrays read are handed over
+  /// without a copy and the caller owns them, call this once.
+  void assignProblem(double *& colLB, double *& colUB,
+                     double *& rowLB, double *& rowUB,
+                     CoinPackedMatrix *& matrix, double *& objCoef,
+                     int & numInteger, int *& integerCols,
+                     int & numCones, int *& coneStart,
+                     int *& coneMembers, int *& coneType);
   double getInfinity() const;
 private:
   DcoCbfIO(DcoCbfIO const &);
@@ -1,4 +1,24 @@
 #include "DcoConGenerator.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoLinearConstraint.hpp"
+
+#include <OsiCuts.hpp>
+#include <CoinTime.hpp>
+#include <CoinHelperFunctions.hpp>
+#include <CoinFinite.hpp>
+
+#include <sstream>
+#include <cmath>
+
+#if defined(DISCO_THREADS)
+#include <pthread.h>
+#endif
+
+extern std::vector<char const *> const dcoConstraintTypeName;
+
+/// Bound improvements smaller than this are not credited to generators.
+static double const dcoCutImpTol = 1e-6;
 
 void DcoConGeneratorStats::reset() {
   numConsGenerated_ = 0;
@@ -6,6 +26,8 @@ void DcoConGeneratorStats::reset() {
   time_ = 0.0;
   numCalls_ = 0;
   numNoConsCalls_ = 0;
+  objImp_ = 0.0;
+  numImpCalls_ = 0;
 }
 
 DcoConGenerator::DcoConGenerator(DcoModel * model,
@@ -15,9 +37,197 @@ DcoConGenerator::DcoConGenerator(DcoModel * model,
                                  int frequency):
   model_(model), type_(type), name_(name), strategy_(strategy),
   frequency_(frequency) {
+  // auto strategy lifts the depth limit when the generator improves the
+  // bound deeper in the tree.
+  maxDepth_ = COIN_INT_MAX;
+  impDepth_ = -1;
   stats_.reset();
 }
 
 DcoConGenerator::~DcoConGenerator() {
   model_ = NULL;
 }
+
+bool DcoConGenerator::generateConstraints(BcpsConstraintPool & conPool) {
+  OsiCuts cuts;
+  generateCuts(model_->solver(), cuts);
+  addCutsToPool(cuts, conPool);
+  return false;
+}
+
+void DcoConGenerator::creditImprovement(double imp, int depth) {
+  if (imp<=dcoCutImpTol) {
+    return;
+  }
+  stats_.addObjImp(imp);
+  stats_.addNumImpCalls(1);
+  impDepth_ = CoinMax(impDepth_, depth);
+}
+
+/*
+  A round of cuts is credited with the bound improvement of the resolve that
+  follows it, split among the generators of the round by the number of their
+  cuts that stayed in the LP (creditImprovement()). Let s be the smoothed rate
+  of calls that got credit and c the separation time of a call in units of
+  the average node time, the resolve is not charged to the generator. Calls
+  every f = ceil(c / (share * min(1, 2s))) nodes keep the generator within
+  share of the node time when s is at least 1/2.
+
+  Cuts lose their value deeper in the tree, since local bounds already carry
+  most of what they would add. After cutDisable calls the generator is kept
+  above twice the deepest node it was credited at and is dropped altogether
+  when it has never been credited.
+*/
+void DcoConGenerator::adapt(double nodeTime) {
+  if (strategy_!=DcoCutStrategyAuto or stats_.numCalls()==0) {
+    return;
+  }
+  double time_share = model_->dcoPar()->entry(DcoParams::cutAutoTimeShare);
+  int max_freq = model_->dcoPar()->entry(DcoParams::cutAutoMaxFreq);
+  double success = (stats_.numImpCalls() + 1.0) / (stats_.numCalls() + 2.0);
+  double cost = stats_.time() / stats_.numCalls();
+  cost = cost / CoinMax(nodeTime, 1.0e-6);
+  double share = time_share * CoinMin(1.0, 2.0*success);
+  double freq = ceil(cost / CoinMax(share, 1.0e-6));
+  frequency_ = static_cast<int>(CoinMin(freq, double(max_freq)));
+  frequency_ = CoinMax(frequency_, 1);
+  // depth limit
+  int min_calls = model_->dcoPar()->entry(DcoParams::cutDisable);
+  if (stats_.numCalls()>min_calls) {
+    maxDepth_ = 2*impDepth_+1;
+  }
+}
+
+int DcoConGenerator::addCutsToPool(OsiCuts & cuts,
+                                   BcpsConstraintPool & conPool) {
+  CoinMessageHandler * message_handler = model_->dcoMessageHandler_;
+  CoinMessages * messages = model_->dcoMessages_;
+  recordCuts(cuts);
+  // debug message
+  message_handler->message(DISCO_CUT_GENERATED, *messages)
+    << model_->broker()->getProcRank()
+    << dcoConstraintTypeName[type()]
+    << cuts.sizeRowCuts()
+    << CoinMessageEol;
+  // create disco constraints
+  int num_added = 0;
+  int num_cuts = cuts.sizeRowCuts();
+  for (int i=0; i<num_cuts; ++i) {
+    OsiRowCut & rcut = cuts.rowCut(i);
+    int len = rcut.row().getNumElements();
+    int const * ind = rcut.row().getIndices();
+    double const * val = rcut.row().getElements();
+    if (len > 0) {
+      // create DcoConstraints from OsiCuts.
+      DcoConstraint * con = new DcoLinearConstraint(len, ind, val, rcut.lb(),
+                                                    rcut.ub());
+      con->setConstraintType(type());
+      conPool.addConstraint(con);
+      num_added++;
+    }
+    else if (len==0) {
+      // Empty cuts
+      std::stringstream msg;
+      msg << "Skipping empty cut generated by "
+          << name();
+      message_handler->message(3000, "Dco", msg.str().c_str(), 'W', 0)
+        << CoinMessageEol;
+    }
+    else {
+      std::stringstream msg;
+      msg << "Negative cut length given by "
+          << name();
+      message_handler->message(9998, "Dco", msg.str().c_str(), 'E', 0)
+        << CoinMessageEol;
+    }
+  }
+  return num_added;
+}
+
+/// Jobs of generateCutsParallel(), shared by the worker threads.
+struct DcoCutJobs {
+  std::vector<DcoConGenerator*> const * gens;
+  std::vector<OsiSolverInterface*> * solvers;
+  std::vector<OsiCuts> * cuts;
+  std::vector<double> * times;
+  /// Index of the next job to be taken.
+  int next;
+#if defined(DISCO_THREADS)
+  /// Guards next.
+  pthread_mutex_t mutex;
+#endif
+};
+
+/// Take jobs until all are taken. arg is a DcoCutJobs.
+static void * dcoCutWorker(void * arg) {
+  DcoCutJobs * jobs = reinterpret_cast<DcoCutJobs*>(arg);
+  int num_jobs = jobs->gens->size();
+  while (true) {
+#if defined(DISCO_THREADS)
+    pthread_mutex_lock(&jobs->mutex);
+#endif
+    int i = jobs->next++;
+#if defined(DISCO_THREADS)
+    pthread_mutex_unlock(&jobs->mutex);
+#endif
+    if (i>=num_jobs) {
+      break;
+    }
+    // CoinCpuTime() is process wide, use wall clock time.
+    double start_time = CoinWallclockTime();
+    (*jobs->gens)[i]->generateCuts((*jobs->solvers)[i], (*jobs->cuts)[i]);
+    (*jobs->times)[i] = CoinWallclockTime() - start_time;
+  }
+  return NULL;
+}
+
+void DcoConGenerator::generateCutsParallel(
+                                 std::vector<DcoConGenerator*> const & gens,
+                                 OsiSolverInterface const * solver,
+                                 std::vector<OsiCuts> & cuts,
+                                 std::vector<double> & times,
+                                 int numThreads) {
+  int num_jobs = gens.size();
+  cuts.clear();
+  cuts.resize(num_jobs);
+  times.assign(num_jobs, 0.0);
+  // clone the solver in this thread, solver interfaces may build row copies
+  // and such lazily which is not safe to do concurrently. Copy the solution
+  // explicitly in case the solver interface does not clone it.
+  std::vector<OsiSolverInterface*> solvers(num_jobs);
+  for (int i=0; i<num_jobs; ++i) {
+    solvers[i] = solver->clone(true);
+    solvers[i]->setColSolution(solver->getColSolution());
+    solvers[i]->setRowPrice(solver->getRowPrice());
+  }
+  DcoCutJobs jobs;
+  jobs.gens = &gens;
+  jobs.solvers = &solvers;
+  jobs.cuts = &cuts;
+  jobs.times = &times;
+  jobs.next = 0;
+#if defined(DISCO_THREADS)
+  pthread_mutex_init(&jobs.mutex, NULL);
+  int num_threads = CoinMin(numThreads, num_jobs);
+  // calling thread is a worker too.
+  std::vector<pthread_t> threads(num_threads>1 ? num_threads-1 : 0);
+  int num_started = 0;
+  for (unsigned int t=0; t<threads.size(); ++t) {
+    if (pthread_create(&threads[t], NULL, dcoCutWorker, &jobs)) {
+      // could not create more threads, the ones we have will take the jobs.
+      break;
+    }
+    num_started++;
+  }
+  dcoCutWorker(&jobs);
+  for (int t=0; t<num_started; ++t) {
+    pthread_join(threads[t], NULL);
+  }
+  pthread_mutex_destroy(&jobs.mutex);
+#else
+  dcoCutWorker(&jobs);
+#endif
+  for (int i=0; i<num_jobs; ++i) {
+    delete solvers[i];
+  }
+}
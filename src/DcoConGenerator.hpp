@@ -3,6 +3,7 @@
 
 #include "Dco.hpp"
 #include <string>
+#include <vector>
 #include <BcpsObjectPool.h>
 
 /*!
@@ -11,18 +12,24 @@
 */
 
 class DcoModel;
+class OsiCuts;
+class OsiSolverInterface;
 
 class DcoConGeneratorStats {
   /// Number of constraints generated by this generator.
   int numConsGenerated_;
   /// Number of constraints that are actually used out of the generated.
   int numConsUsed_;
-  /// CPU/User time this generator consumed.
+  /// Wall clock time this generator consumed.
   double time_;
   /// Number of times this generator is called.
   int numCalls_;
   /// Number of times this generator is called and did not yield any cuts.
   int numNoConsCalls_;
+  /// Bound improvement attributed to this generator.
+  double objImp_;
+  /// Number of calls the bound improved after.
+  int numImpCalls_;
 public:
   /// Default constructor
   DcoConGeneratorStats() { reset(); }
@@ -36,12 +43,16 @@ public:
   int numConsGenerated() const { return numConsGenerated_; }
   /// Get number of constraints that are actually used out of the generated.
   int numConsUsed() const { return numConsUsed_; }
-  /// Get CPU/User time this generator consumed.
+  /// Get wall clock time this generator consumed.
   double time() const { return time_; }
   /// Get number of times this generator is called.
   int numCalls() const { return numCalls_; }
   /// Get number of times this generator is called and did not yield any cuts.
   int numNoConsCalls() const { return numNoConsCalls_; }
+  /// Get bound improvement attributed to this generator.
+  double objImp() const { return objImp_; }
+  /// Get number of calls the bound improved after.
+  int numImpCalls() const { return numImpCalls_; }
   //@}
 
   ///@name Update Statistics
@@ -52,12 +63,16 @@ public:
   void addNumConsGenerated(int n) { numConsGenerated_ += n; }
   /// Increase the number of generated and used constraints.
   void addNumConsUsed(int n) { numConsUsed_ += n; }
-  /// Increase Cpu time used.
+  /// Increase wall clock time used.
   void addTime(double t) { time_ += t; }
   /// Increase the number of calls.
   void addNumCalls(int n=1) { numCalls_ += n; }
   /// Increase the number of calls and no constraints generated.
   void addNumNoConsCalls(int n=1) { numNoConsCalls_ += n; }
+  /// Increase the bound improvement attributed to this generator.
+  void addObjImp(double imp) { objImp_ += imp; }
+  /// Increase the number of calls the bound improved after.
+  void addNumImpCalls(int n=1) { numImpCalls_ += n; }
   //@}
 };
 
@@ -80,6 +95,12 @@ class DcoConGenerator {
   DcoCutStrategy strategy_;
   /// The frequency of calls to the cut generator.
   int frequency_;
+  /// Generator is not called at nodes deeper than this when strategy is
+  /// auto.
+  int maxDepth_;
+  /// Deepest node the bound improved after a call of this generator, -1 if
+  /// it never improved.
+  int impDepth_;
   //@}
 
 public:
@@ -99,7 +120,42 @@ public:
   //@{
   /// Generate constraints and add them to the pool.  return true if resolve is
   /// needed (because the state of the solver interface has been modified).
-  virtual bool generateConstraints(BcpsConstraintPool & conPool) = 0;
+  /// Default implementation calls generateCuts() with the model's solver and
+  /// addCutsToPool().
+  virtual bool generateConstraints(BcpsConstraintPool & conPool);
+  /// Generate cuts for the current solution of the given solver and store
+  /// them in cuts. Implementations should not log and should not use the
+  /// model's solver, generators working on different solvers may run
+  /// concurrently.
+  virtual void generateCuts(OsiSolverInterface * solver, OsiCuts & cuts) = 0;
+  /// Create Disco constraints from cuts and add them to the pool. Returns
+  /// the number of constraints added. Calls recordCuts() first.
+  int addCutsToPool(OsiCuts & cuts, BcpsConstraintPool & conPool);
+  /// Called on the main thread with the cuts of generateCuts() before they
+  /// are added to the pool. Generators that learn from their cuts, like
+  /// probing, override it. Default implementation does nothing.
+  virtual void recordCuts(OsiCuts const & cuts) {}
+  /// Run generateCuts() of generators gens[i] on numThreads threads. Every
+  /// generator works on its own clone of solver, cuts of gens[i] are stored
+  /// in cuts[i] and the wall clock time it took in times[i]. The results do
+  /// not depend on the order threads finish. Generators run one after
+  /// another when threads are not available.
+  static void generateCutsParallel(std::vector<DcoConGenerator*> const & gens,
+                                   OsiSolverInterface const * solver,
+                                   std::vector<OsiCuts> & cuts,
+                                   std::vector<double> & times,
+                                   int numThreads);
+  //@}
+
+  ///@name Scheduling
+  //@{
+  /// Credit imp, the bound improvement attributed to the last call of this
+  /// generator at a node at the given depth.
+  void creditImprovement(double imp, int depth);
+  /// Adapt call frequency and depth limit to the bound improvement
+  /// attributed to the generator. Does nothing unless strategy is auto.
+  /// nodeTime is the average time spent for processing a node.
+  void adapt(double nodeTime);
   //@}
 
   /// Update Fields
@@ -119,6 +175,8 @@ public:
   DcoCutStrategy strategy() const { return strategy_; }
   /// Get the frequency of calls to this cut generator.
   int frequency() const { return frequency_; }
+  /// Get depth limit of auto strategy.
+  int maxDepth() const { return maxDepth_; }
   /// Get type of generator
   DcoConstraintType type() const { return type_; }
   //@}
@@ -3,11 +3,27 @@
 
 #include "DcoConGenerator.hpp"
 
+#include <OsiLorentzCone.hpp>
+#include <vector>
+
 class CglConicCutGenerator;
 
 class DcoConicConGenerator: virtual public DcoConGenerator {
   /// The CglCutGenerator object.
   CglConicCutGenerator * generator_;
+  ///@name Cones passed to OA separator in the current round.
+  //@{
+  /// Infeasibility of relaxed cones, used when model does not have them
+  /// for the current solution.
+  std::vector<double> infeas_;
+  /// Relaxed cone indices, most violated first.
+  std::vector<int> order_;
+  std::vector<OsiLorentzConeType> types_;
+  std::vector<int> sizes_;
+  std::vector<int const *> members_;
+  //@}
+  /// Generate OA cuts for the violated cones only.
+  void generateOaCuts(OsiSolverInterface * solver, OsiCuts & cuts);
 public:
   ///@name Constructors and Destructor
   //@{
@@ -25,8 +41,8 @@ public:
 
   ///@name Constraint generator functions
   //@{
-  /// Generate constraints and add them to the pool.
-  bool generateConstraints(BcpsConstraintPool & conPool);
+  /// Generate cuts for the current solution of solver.
+  virtual void generateCuts(OsiSolverInterface * solver, OsiCuts & cuts);
   //@}
 
   // Get cut generator.
@@ -85,43 +85,42 @@ double DcoConicConstraint::infeasibility(BcpsModel * m,
   DcoModel * model = dynamic_cast<DcoModel*>(m);
   CoinMessageHandler * message_handler = model->dcoMessageHandler_;
   CoinMessages * messages = model->dcoMessages_;
-  double infeasibility;
+  if (coneType_!=DcoLorentzCone and coneType_!=DcoRotatedLorentzCone) {
+    // unknown cone type.
+    message_handler->message(DISCO_UNKNOWN_CONETYPE, *messages)
+      << __FILE__ << __LINE__ << CoinMessageEol;
+    throw std::exception();
+  }
   // get solution stored in solver
   double const * sol = model->solver()->getColSolution();
-  // get related portion of the solution
-  double * par_sol = new double[coneSize_];
-  for(int i=0; i<coneSize_; ++i) {
-    par_sol[i] = sol[members_[i]];
-  }
+  double infeas = infeasibility(sol);
   // get cone tolerance
   double cone_tol = model->dcoPar()->entry(DcoParams::coneTol);
+  if (infeas<=cone_tol) {
+    infeas = 0.0;
+  }
+  return infeas;
+}
+
+double DcoConicConstraint::infeasibility(double const * sol) const {
+  double infeasibility = 0.0;
   if (coneType_==DcoLorentzCone) {
-    // infeasibility is
-    // |x_2n| - x_1, if |x_2n| - x_1 > coneTol
-    //  0 otherwise
-    double * p = par_sol;
-    double norm = std::inner_product(p+1, p+coneSize_, p+1, 0.0);
+    // infeasibility is |x_2n| - x_1
+    double norm = 0.0;
+    for (int i=1; i<coneSize_; ++i) {
+      norm += sol[members_[i]]*sol[members_[i]];
+    }
     norm = sqrt(norm);
-    infeasibility = norm - p[0];
+    infeasibility = norm - sol[members_[0]];
   }
   else if (coneType_==DcoRotatedLorentzCone) {
-    // infeasibility is
-    // |x_3n|^2 - 2x_1x_2, if |x_3n|^2 - 2x_1x_2, > coneTol
-    //  0 otherwise
-    double * p = par_sol;
-    double ss = std::inner_product(p+2, p+coneSize_, p+2, 0.0);
-    infeasibility = ss - 2.0*p[0]*p[1];
-  }
-  else {
-    // unknown cone type.
-    message_handler->message(DISCO_UNKNOWN_CONETYPE, *messages)
-      << __FILE__ << __LINE__ << CoinMessageEol;
-    throw std::exception();
-  }
-  if (infeasibility<=cone_tol) {
-    infeasibility = 0.0;
+    // infeasibility is |x_3n|^2 - 2x_1x_2
+    double ss = 0.0;
+    for (int i=2; i<coneSize_; ++i) {
+      ss += sol[members_[i]]*sol[members_[i]];
+    }
+    infeasibility = ss - 2.0*sol[members_[0]]*sol[members_[1]];
   }
-  delete[] par_sol;
   return infeasibility;
 }
 
@@ -57,6 +57,12 @@ public:
   virtual double infeasibility(BcpsModel * m, int & preferredWay) const;
   //@}
 
+  /// Return infeasibility of this at the given point, sol is a full column
+  /// solution. It is ||x_2n|| - x_1 for Lorentz cones and
+  /// ||x_3n||^2 - 2x_1x_2 for rotated Lorentz cones. Cone tolerance is not
+  /// applied, a positive value means the point is out of the cone.
+  double infeasibility(double const * sol) const;
+
   ///@name Querry constraint information.
   //@{
   /// Returns type of conic constraint.
@@ -0,0 +1,200 @@
+#include "DcoConicMirGenerator.hpp"
+#include "DcoModel.hpp"
+
+#include <OsiCuts.hpp>
+
+#include <cmath>
+
+/// Cuts violated less than this are not added.
+static double const dcoConicMirViolTol = 1e-6;
+/// Cuts with fractional part of b/alpha closer than this to 0 or 1 are not
+/// tried.
+static double const dcoConicMirFracTol = 1e-4;
+/// Integer members with values closer than this to an integer are treated
+/// as integral.
+static double const dcoConicMirIntTol = 1e-6;
+
+/// Conic MIR function of Atamturk and Narayanan.
+static double dcoConicMirPhi(double a, double f) {
+  double n = floor(a);
+  double r = a - n;
+  if (r<f) {
+    return (1.0-2.0*f)*n - r;
+  }
+  return (1.0-2.0*f)*n + r - 2.0*f;
+}
+
+/// Useful constructor.
+DcoConicMirGenerator::DcoConicMirGenerator(DcoModel * model,
+                                           char const * name,
+                                           DcoCutStrategy strategy,
+                                           int frequency):
+  DcoConGenerator(model, DcoConstraintTypeCMIR, name, strategy, frequency) {
+}
+
+/// Destructor.
+DcoConicMirGenerator::~DcoConicMirGenerator() {
+}
+
+bool DcoConicMirGenerator::separateCone(int cone, double const * sol,
+                                        OsiCuts & cuts) {
+  DcoModel * model = DcoConGenerator::model();
+  int size = model->coneSizes()[cone];
+  int const * members = model->coneMemberPtrs()[cone];
+  bool rotated = model->coneOsiTypes()[cone]==OSI_RQUAD;
+  int first = rotated ? 2 : 1;
+  std::vector<BcpsVariable*> & vars = model->getVariables();
+  // u is y/||y|| at the current solution.
+  double norm = 0.0;
+  for (int i=first; i<size; ++i) {
+    norm += sol[members[i]]*sol[members[i]];
+  }
+  norm = sqrt(norm);
+  if (norm<dcoConicMirIntTol) {
+    return false;
+  }
+  // substitute bounds, u_i y_i is coef[i] x_i + u_i base[i] where x_i is
+  // nonnegative and dir[i] x_i = y_i - base[i].
+  int num_terms = size - first;
+  std::vector<double> coef(num_terms);
+  std::vector<double> base(num_terms);
+  std::vector<double> dir(num_terms);
+  std::vector<double> value(num_terms);
+  std::vector<bool> integer(num_terms);
+  double b = 0.0;
+  for (int i=0; i<num_terms; ++i) {
+    int col = members[first+i];
+    double u = sol[col]/norm;
+    double lb = vars[col]->getLbHard();
+    double ub = vars[col]->getUbHard();
+    integer[i] = vars[col]->getIntType()=='I';
+    if (lb>-COIN_DBL_MAX) {
+      base[i] = integer[i] ? ceil(lb-dcoConicMirIntTol) : lb;
+      dir[i] = 1.0;
+    }
+    else if (ub<COIN_DBL_MAX) {
+      base[i] = integer[i] ? floor(ub+dcoConicMirIntTol) : ub;
+      dir[i] = -1.0;
+    }
+    else {
+      // free member, bounds can not be substituted.
+      return false;
+    }
+    coef[i] = dir[i]*u;
+    b -= u*base[i];
+    value[i] = dir[i]*(sol[col]-base[i]);
+  }
+  // t at the current solution
+  double t = rotated ? (sol[members[0]]+sol[members[1]])/sqrt(2.0) :
+    sol[members[0]];
+  // try scaling factors, keep the most violated one. Violation is scaled
+  // with alpha so it is in units of t.
+  double best_alpha = 0.0;
+  double best_viol = dcoConicMirViolTol;
+  for (int k=0; k<num_terms; ++k) {
+    double alpha = fabs(coef[k]);
+    if (!integer[k] or alpha<dcoConicMirIntTol) {
+      continue;
+    }
+    double beta = b/alpha;
+    double f = beta - floor(beta);
+    if (f<dcoConicMirFracTol or f>1.0-dcoConicMirFracTol) {
+      continue;
+    }
+    double lhs = -dcoConicMirPhi(beta, f);
+    double rhs = t;
+    for (int i=0; i<num_terms; ++i) {
+      if (integer[i]) {
+        lhs += dcoConicMirPhi(coef[i]/alpha, f)*value[i];
+      }
+      else {
+        rhs += fabs(coef[i])*value[i];
+      }
+    }
+    double viol = alpha*lhs - rhs;
+    if (viol>best_viol) {
+      best_viol = viol;
+      best_alpha = alpha;
+    }
+  }
+  if (best_alpha==0.0) {
+    return false;
+  }
+  // cut scaled by alpha,
+  // sum alpha phi_i x_i - sum |coef_i| z_i - t <= alpha phi(beta),
+  // write it in terms of the problem columns.
+  double alpha = best_alpha;
+  double beta = b/alpha;
+  double f = beta - floor(beta);
+  double cut_ub = alpha*dcoConicMirPhi(beta, f);
+  coef_.resize(model->getNumCoreVariables(), 0.0);
+  inCut_.resize(model->getNumCoreVariables(), false);
+  cols_.clear();
+  for (int i=0; i<num_terms; ++i) {
+    int col = members[first+i];
+    double c;
+    if (integer[i]) {
+      c = alpha*dcoConicMirPhi(coef[i]/alpha, f);
+    }
+    else {
+      c = -fabs(coef[i]);
+    }
+    // c x_i is c dir_i y_i - c dir_i base_i
+    if (!inCut_[col]) {
+      inCut_[col] = true;
+      cols_.push_back(col);
+    }
+    coef_[col] += c*dir[i];
+    cut_ub += c*dir[i]*base[i];
+  }
+  double t_coef = rotated ? -1.0/sqrt(2.0) : -1.0;
+  for (int i=0; i<first; ++i) {
+    if (!inCut_[members[i]]) {
+      inCut_[members[i]] = true;
+      cols_.push_back(members[i]);
+    }
+    coef_[members[i]] += t_coef;
+  }
+  std::vector<double> vals(cols_.size());
+  for (unsigned int i=0; i<cols_.size(); ++i) {
+    vals[i] = coef_[cols_[i]];
+    coef_[cols_[i]] = 0.0;
+    inCut_[cols_[i]] = false;
+  }
+  OsiRowCut cut;
+  cut.setRow(cols_.size(), &cols_[0], &vals[0]);
+  cut.setLb(-COIN_DBL_MAX);
+  cut.setUb(cut_ub);
+  cuts.insert(cut);
+  return true;
+}
+
+/// Generate cuts for the current solution of solver.
+void DcoConicMirGenerator::generateCuts(OsiSolverInterface * solver,
+                                        OsiCuts & cuts) {
+  DcoModel * model = DcoConGenerator::model();
+  double const * sol = solver->getColSolution();
+  std::vector<BcpsVariable*> & vars = model->getVariables();
+  // notes(aykut) relaxed rows are the conic rows in core order, relaxed row
+  // i is cone i.
+  int num_cones = model->numRelaxedRows();
+  int const * sizes = model->coneSizes();
+  int const * const * members = model->coneMemberPtrs();
+  OsiLorentzConeType const * types = model->coneOsiTypes();
+  for (int k=0; k<num_cones; ++k) {
+    // cones with a fractional integer member only
+    int first = (types[k]==OSI_RQUAD) ? 2 : 1;
+    bool fractional = false;
+    for (int i=first; i<sizes[k]; ++i) {
+      int col = members[k][i];
+      if (vars[col]->getIntType()=='I' and
+          fabs(sol[col]-floor(sol[col]+0.5))>dcoConicMirIntTol) {
+        fractional = true;
+        break;
+      }
+    }
+    if (fractional) {
+      separateCone(k, sol, cuts);
+    }
+  }
+}
@@ -0,0 +1,72 @@
+#ifndef DcoConicMirGenerator_hpp_
+#define DcoConicMirGenerator_hpp_
+
+#include "DcoConGenerator.hpp"
+
+#include <vector>
+
+/*!
+  DcoConicMirGenerator generates conic mixed integer rounding cuts of
+  Atamturk and Narayanan for the relaxed conic constraints.
+
+  For a cone t >= ||y|| and a unit vector u, |u^T y| <= ||y|| <= t. We take u
+  in the direction of y at the current solution and substitute bounds so
+  that integer members are nonnegative integers x and continuous members are
+  nonnegative reals z. This gives
+
+  |a^T x + g^T z - b| <= t, hence |a^T x - b| <= t + |g|^T z,
+
+  a polyhedral conic mixed integer set. For alpha > 0 and f = b/alpha -
+  floor(b/alpha) > 0 the conic MIR inequality
+
+  sum_j phi_f(a_j/alpha) x_j - phi_f(b/alpha) <= (t + |g|^T z)/alpha
+
+  is valid, where phi_f(a) = (1-2f)n - (a-n) if a-n < f and
+  (1-2f)n + (a-n) - 2f otherwise, n = floor(a). Scaling alpha is chosen
+  among |a_j| of the integer members, the most violated cut is kept. For
+  rotated cones 2t_1t_2 >= ||y||^2, t is (t_1+t_2)/sqrt(2).
+
+  Cones are not required to be violated, fractional integer members are
+  enough. Global bounds of the variables are used, cuts are globally valid.
+*/
+
+class DcoConicMirGenerator: virtual public DcoConGenerator {
+  ///@name Scratch space.
+  //@{
+  /// Coefficients of the cut in terms of the problem columns, dense.
+  std::vector<double> coef_;
+  /// Columns of the cut, inCut_[i] is true if column i is in cols_.
+  std::vector<int> cols_;
+  std::vector<bool> inCut_;
+  //@}
+  /// Generate the conic MIR cut of cone for solution sol, returns true and
+  /// inserts it to cuts if it is violated.
+  bool separateCone(int cone, double const * sol, OsiCuts & cuts);
+public:
+  ///@name Constructors and Destructor
+  //@{
+  /// Useful constructor.
+  DcoConicMirGenerator(DcoModel * model,
+                       char const * name = NULL,
+                       DcoCutStrategy strategy = DcoCutStrategyAuto,
+                       int frequency = 1);
+  /// Destructor.
+  virtual ~DcoConicMirGenerator();
+  //@}
+
+  ///@name Constraint generator functions
+  //@{
+  /// Generate cuts for the current solution of solver.
+  virtual void generateCuts(OsiSolverInterface * solver, OsiCuts & cuts);
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoConicMirGenerator();
+  /// Disable copy constructor.
+  DcoConicMirGenerator(DcoConicMirGenerator const & other);
+  /// Disable copy assignment operator.
+  DcoConicMirGenerator & operator=(DcoConicMirGenerator const & rhs);
+};
+
+#endif
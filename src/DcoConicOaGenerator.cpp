@@ -0,0 +1,184 @@
+#include "DcoConicOaGenerator.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoSolution.hpp"
+#include "DcoLinearConstraint.hpp"
+
+#include <OsiCuts.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+extern std::vector<char const *> const dcoConstraintTypeName;
+
+/// Cones with ||w(p)|| smaller than this are not linearized at p, gradient
+/// is not defined at the apex.
+static double const dcoOaMinNorm = 1e-10;
+/// Two cuts of a cone are the same if no coefficient differs more than this.
+static double const dcoOaSameCutTol = 1e-9;
+
+/// Useful constructor.
+DcoConicOaGenerator::DcoConicOaGenerator(DcoModel * model,
+                                         char const * name,
+                                         DcoCutStrategy strategy,
+                                         int frequency):
+  DcoConGenerator(model, DcoConstraintTypeOA, name, strategy, frequency) {
+  cutStart_.push_back(0);
+}
+
+/// Destructor.
+DcoConicOaGenerator::~DcoConicOaGenerator() {
+}
+
+bool DcoConicOaGenerator::addCut(int cone, double tol, bool check) {
+  DcoModel * model = DcoConGenerator::model();
+  int size = model->coneSizes()[cone];
+  int const * members = model->coneMemberPtrs()[cone];
+  bool rotated = model->coneOsiTypes()[cone]==OSI_RQUAD;
+  double const * p = &point_[0];
+  double const * x = &current_[0];
+  // norm of w(p), v is the first entry of w for rotated cones.
+  int first = rotated ? 2 : 1;
+  double v = 0.0;
+  double ss = 0.0;
+  for (int i=first; i<size; ++i) {
+    ss += p[i]*p[i];
+  }
+  if (rotated) {
+    v = (p[0]-p[1])/sqrt(2.0);
+    ss += v*v;
+  }
+  double norm = sqrt(ss);
+  if (norm<dcoOaMinNorm) {
+    return false;
+  }
+  // write coefficients, cut is scaled so that coefficients of w are
+  // w(p)/||w(p)||, sqrt(2) w(p)/||w(p)|| for rotated cones.
+  int start = cutInd_.size();
+  cutInd_.resize(start+size);
+  cutVal_.resize(start+size);
+  int * ind = &cutInd_[start];
+  double * val = &cutVal_[start];
+  std::copy(members, members+size, ind);
+  double scale;
+  if (rotated) {
+    val[0] = -(1.0 - v/norm);
+    val[1] = -(1.0 + v/norm);
+    scale = sqrt(2.0)/norm;
+  }
+  else {
+    val[0] = -1.0;
+    scale = 1.0/norm;
+  }
+  for (int i=first; i<size; ++i) {
+    val[i] = scale*p[i];
+  }
+  // violation at the current solution
+  double activity = 0.0;
+  for (int i=0; i<size; ++i) {
+    activity += val[i]*x[i];
+  }
+  bool keep = activity>tol;
+  if (keep and check and cutStart_.size()>1) {
+    // compare with the last cut in the buffer
+    int last = cutStart_[cutStart_.size()-2];
+    if (start-last==size and std::equal(ind, ind+size, &cutInd_[last])) {
+      double diff = 0.0;
+      for (int i=0; i<size; ++i) {
+        diff = std::max(diff, fabs(val[i]-cutVal_[last+i]));
+      }
+      keep = diff>dcoOaSameCutTol;
+    }
+  }
+  if (!keep) {
+    cutInd_.resize(start);
+    cutVal_.resize(start);
+    return false;
+  }
+  cutStart_.push_back(cutInd_.size());
+  return true;
+}
+
+int DcoConicOaGenerator::separate(double const * sol) {
+  cutStart_.assign(1, 0);
+  cutInd_.clear();
+  cutVal_.clear();
+  DcoModel * model = DcoConGenerator::model();
+  model->violatedRelaxedRows(sol, infeas_, cones_);
+  if (cones_.empty()) {
+    return 0;
+  }
+  double cone_tol = model->dcoPar()->entry(DcoParams::coneTol);
+  // incumbent is the second linearization point
+  double const * incumbent = NULL;
+  if (model->dcoPar()->entry(DcoParams::cutOaIncumbent) and
+      model->broker()->hasKnowledge(AlpsKnowledgeTypeSolution)) {
+    DcoSolution * best = dynamic_cast<DcoSolution*>
+      (model->broker()->getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+    incumbent = best->getValues();
+  }
+  // notes(aykut) relaxed rows are the conic rows in core order, relaxed row
+  // i is cone i.
+  int const * sizes = model->coneSizes();
+  int const * const * members = model->coneMemberPtrs();
+  int num_cones = cones_.size();
+  for (int k=0; k<num_cones; ++k) {
+    int cone = cones_[k];
+    int size = sizes[cone];
+    int const * cone_members = members[cone];
+    current_.resize(size);
+    point_.resize(size);
+    for (int i=0; i<size; ++i) {
+      current_[i] = sol[cone_members[i]];
+    }
+    // current point, cone is violated so the cut is violated too.
+    std::copy(current_.begin(), current_.end(), point_.begin());
+    addCut(cone, 0.0, false);
+    if (incumbent) {
+      for (int i=0; i<size; ++i) {
+        point_[i] = incumbent[cone_members[i]];
+      }
+      addCut(cone, cone_tol, true);
+    }
+  }
+  return cutStart_.size()-1;
+}
+
+bool DcoConicOaGenerator::generateConstraints(BcpsConstraintPool & conPool) {
+  DcoModel * model = DcoConGenerator::model();
+  int num_cuts = separate(model->solver()->getColSolution());
+  // debug message
+  model->dcoMessageHandler_->message(DISCO_CUT_GENERATED,
+                                     *model->dcoMessages_)
+    << model->broker()->getProcRank()
+    << dcoConstraintTypeName[type()]
+    << num_cuts
+    << CoinMessageEol;
+  double infinity = model->solver()->getInfinity();
+  for (int i=0; i<num_cuts; ++i) {
+    int start = cutStart_[i];
+    int len = cutStart_[i+1] - start;
+    DcoConstraint * con = new DcoLinearConstraint(len, &cutInd_[start],
+                                                  &cutVal_[start],
+                                                  -infinity, 0.0);
+    con->setConstraintType(type());
+    conPool.addConstraint(con);
+  }
+  return false;
+}
+
+/// Generate cuts for the current solution of solver.
+void DcoConicOaGenerator::generateCuts(OsiSolverInterface * solver,
+                                       OsiCuts & cuts) {
+  int num_cuts = separate(solver->getColSolution());
+  double infinity = solver->getInfinity();
+  for (int i=0; i<num_cuts; ++i) {
+    int start = cutStart_[i];
+    int len = cutStart_[i+1] - start;
+    OsiRowCut cut;
+    cut.setRow(len, &cutInd_[start], &cutVal_[start]);
+    cut.setLb(-infinity);
+    cut.setUb(0.0);
+    cuts.insert(cut);
+  }
+}
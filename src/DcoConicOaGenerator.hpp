@@ -0,0 +1,91 @@
+#ifndef DcoConicOaGenerator_hpp_
+#define DcoConicOaGenerator_hpp_
+
+#include "DcoConGenerator.hpp"
+
+#include <vector>
+
+/*!
+  DcoConicOaGenerator separates outer approximation cuts for the relaxed
+  conic constraints without going through Cgl.
+
+  Every cone is written as a Lorentz cone u >= ||w||. For a Lorentz cone u is
+  x_1 and w is x_2n. For a rotated cone 2x_1x_2 >= ||x_3n||^2 (x_1, x_2 >= 0),
+  u is (x_1+x_2)/sqrt(2) and w is ((x_1-x_2)/sqrt(2), x_3n). The gradient cut
+  at a point p with w(p) nonzero is
+
+  -u + w(p)^T w / ||w(p)|| <= 0,
+
+  it is computed analytically in terms of the cone members. The cut depends
+  only on the direction of w(p). Projection of p onto the cone keeps this
+  direction, the cut at the current point is the supporting hyperplane at its
+  projection.
+
+  Cones are linearized at the current point and, when cutOaIncumbent is set,
+  at the incumbent. The incumbent cut is kept only if it is violated by the
+  current point and differs from the cut of the current point. Cones are
+  taken from DcoModel::violatedRelaxedRows(), most violated first.
+
+  Cuts are written into a CSR buffer owned by the generator, they have the
+  form a^T x <= 0. generateConstraints() creates DcoLinearConstraint objects
+  from the buffer directly, generateCuts() creates OsiRowCut objects for the
+  parallel cut loop.
+*/
+
+class DcoConicOaGenerator: virtual public DcoConGenerator {
+  ///@name Cut buffer, cut i is in [cutStart_[i], cutStart_[i+1]).
+  //@{
+  std::vector<int> cutStart_;
+  std::vector<int> cutInd_;
+  std::vector<double> cutVal_;
+  //@}
+  ///@name Scratch space.
+  //@{
+  /// Relaxed rows separated in the current round.
+  std::vector<int> cones_;
+  /// Infeasibilities of relaxed rows when the model does not have them.
+  std::vector<double> infeas_;
+  /// Values of cone members at the linearization point.
+  std::vector<double> point_;
+  /// Values of cone members at the current solution.
+  std::vector<double> current_;
+  //@}
+  /// Append the gradient cut of cone at point_ to the buffer if it is
+  /// violated by current_ more than tol. If check is true the cut is not
+  /// appended when it is the same as the last cut of the buffer. Returns true
+  /// if the cut is appended.
+  bool addCut(int cone, double tol, bool check);
+  /// Separate cuts for solution sol into the buffer, returns the number of
+  /// cuts.
+  int separate(double const * sol);
+public:
+  ///@name Constructors and Destructor
+  //@{
+  /// Useful constructor.
+  DcoConicOaGenerator(DcoModel * model,
+                      char const * name = NULL,
+                      DcoCutStrategy strategy = DcoCutStrategyAuto,
+                      int frequency = 1);
+  /// Destructor.
+  virtual ~DcoConicOaGenerator();
+  //@}
+
+  ///@name Constraint generator functions
+  //@{
+  /// Generate cuts for the solution of the model's solver and add them to
+  /// the pool without creating OsiRowCut objects.
+  virtual bool generateConstraints(BcpsConstraintPool & conPool);
+  /// Generate cuts for the current solution of solver.
+  virtual void generateCuts(OsiSolverInterface * solver, OsiCuts & cuts);
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoConicOaGenerator();
+  /// Disable copy constructor.
+  DcoConicOaGenerator(DcoConicOaGenerator const & other);
+  /// Disable copy assignment operator.
+  DcoConicOaGenerator & operator=(DcoConicOaGenerator const & rhs);
+};
+
+#endif
@@ -0,0 +1,227 @@
+#include "DcoHeurExecutor.hpp"
+#include "DcoHeuristic.hpp"
+#include "DcoModel.hpp"
+#include "DcoSolution.hpp"
+
+#include <CoinTime.hpp>
+#include <CoinError.hpp>
+#include <CoinMessageHandler.hpp>
+
+DcoHeurExecutor::DcoHeurExecutor(DcoModel * model) {
+  model_ = model;
+  // worker logs through a copy of the model's handler, CoinMessageHandler
+  // keeps the message being built in the handler.
+  messageHandler_ = new CoinMessageHandler(*model->dcoMessageHandler_);
+  jobSolver_ = NULL;
+  jobIndex_ = 0;
+  jobNodeTime_ = 0.0;
+  numJobs_ = 0;
+  numDropped_ = 0;
+  stop_ = false;
+#if defined(DISCO_THREADS)
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&jobCond_, NULL);
+  pthread_cond_init(&doneCond_, NULL);
+  if (pthread_create(&thread_, NULL, workerEntry, this)) {
+    throw CoinError("Can not create heuristic worker thread.",
+                    "DcoHeurExecutor", "DcoHeurExecutor");
+  }
+#endif
+}
+
+DcoHeurExecutor::~DcoHeurExecutor() {
+#if defined(DISCO_THREADS)
+  pthread_mutex_lock(&mutex_);
+  stop_ = true;
+  pthread_cond_signal(&jobCond_);
+  pthread_mutex_unlock(&mutex_);
+  pthread_join(thread_, NULL);
+  pthread_cond_destroy(&doneCond_);
+  pthread_cond_destroy(&jobCond_);
+  pthread_mutex_destroy(&mutex_);
+#endif
+  if (jobSolver_) {
+    delete jobSolver_;
+    jobSolver_ = NULL;
+  }
+  while (!solutions_.empty()) {
+    delete solutions_.front();
+    solutions_.pop();
+  }
+  delete messageHandler_;
+}
+
+void DcoHeurExecutor::lock() {
+#if defined(DISCO_THREADS)
+  pthread_mutex_lock(&mutex_);
+#endif
+}
+
+void DcoHeurExecutor::unlock() {
+#if defined(DISCO_THREADS)
+  pthread_mutex_unlock(&mutex_);
+#endif
+}
+
+#if defined(DISCO_THREADS)
+void * DcoHeurExecutor::workerEntry(void * arg) {
+  DcoHeurExecutor * executor = reinterpret_cast<DcoHeurExecutor*>(arg);
+  executor->workerLoop();
+  return NULL;
+}
+#endif
+
+void DcoHeurExecutor::workerLoop() {
+#if defined(DISCO_THREADS)
+  pthread_mutex_lock(&mutex_);
+  while (true) {
+    while (jobSolver_==NULL and stop_==false) {
+      pthread_cond_wait(&jobCond_, &mutex_);
+    }
+    if (stop_) {
+      break;
+    }
+    // run the job without holding the lock, main thread only reads the queue
+    // and checks whether we are busy in the meantime.
+    pthread_mutex_unlock(&mutex_);
+    runHeuristics(jobSolver_);
+    pthread_mutex_lock(&mutex_);
+    delete jobSolver_;
+    jobSolver_ = NULL;
+    pthread_cond_broadcast(&doneCond_);
+  }
+  pthread_mutex_unlock(&mutex_);
+#endif
+}
+
+#if defined(__OA__)
+void DcoHeurExecutor::runHeuristics(OsiSolverInterface * solver) {
+#else
+void DcoHeurExecutor::runHeuristics(OsiConicSolverInterface * solver) {
+#endif
+  long unsigned int num_heur = model_->numHeuristics();
+  for (long unsigned int i=0; i<num_heur; ++i) {
+    DcoHeuristic * curr = model_->heuristics(i);
+    // schedules and statistics are read by submit() in the main thread,
+    // access them holding the lock.
+    lock();
+    bool call = curr->shouldCall(jobIndex_);
+    unlock();
+    if (!call) {
+      continue;
+    }
+    curr->setSolver(solver);
+    curr->setMessageHandler(messageHandler_);
+    // CoinCpuTime() is process wide, it would count the time of the main
+    // thread too. Use wall clock time instead.
+    double start_time = CoinWallclockTime();
+    DcoSolution * sol = curr->searchSolution();
+    double heur_time = CoinWallclockTime() - start_time;
+    curr->setMessageHandler(NULL);
+    curr->setSolver(NULL);
+    lock();
+    curr->stats().addCall(heur_time, sol!=NULL);
+    curr->adapt(jobNodeTime_);
+    unlock();
+    if (sol) {
+      pushSolution(curr, sol);
+    }
+  }
+}
+
+void DcoHeurExecutor::pushSolution(DcoHeuristic * heur, DcoSolution * sol) {
+  lock();
+  solutions_.push(sol);
+  finders_.push(heur);
+  unlock();
+}
+
+#if defined(__OA__)
+bool DcoHeurExecutor::submit(OsiSolverInterface const * solver,
+                             int nodeIndex, double nodeTime) {
+#else
+bool DcoHeurExecutor::submit(OsiConicSolverInterface const * solver,
+                             int nodeIndex, double nodeTime) {
+#endif
+  lock();
+  if (jobSolver_) {
+    numDropped_++;
+    unlock();
+    return false;
+  }
+  // Do not bother cloning the solver if no heuristic wants this node.
+  // Schedules are adapted by the worker, read them holding the lock.
+  bool call = false;
+  long unsigned int num_heur = model_->numHeuristics();
+  for (long unsigned int i=0; i<num_heur; ++i) {
+    if (model_->heuristics(i)->shouldCall(nodeIndex)) {
+      call = true;
+      break;
+    }
+  }
+  unlock();
+  if (!call) {
+    return false;
+  }
+  // take the snapshot in the calling thread, the solver will change once we
+  // return. Clone has the node bounds and cuts, copy the LP solution
+  // explicitly in case the solver interface does not clone it.
+#if defined(__OA__)
+  OsiSolverInterface * clone = solver->clone(true);
+#else
+  OsiConicSolverInterface * clone =
+    dynamic_cast<OsiConicSolverInterface*>(solver->clone(true));
+#endif
+  clone->setColSolution(solver->getColSolution());
+  clone->setRowPrice(solver->getRowPrice());
+#if defined(DISCO_THREADS)
+  pthread_mutex_lock(&mutex_);
+  jobSolver_ = clone;
+  jobIndex_ = nodeIndex;
+  jobNodeTime_ = nodeTime;
+  numJobs_++;
+  pthread_cond_signal(&jobCond_);
+  pthread_mutex_unlock(&mutex_);
+#else
+  jobIndex_ = nodeIndex;
+  jobNodeTime_ = nodeTime;
+  numJobs_++;
+  runHeuristics(clone);
+  delete clone;
+#endif
+  return true;
+}
+
+bool DcoHeurExecutor::busy() {
+  bool busy = false;
+#if defined(DISCO_THREADS)
+  pthread_mutex_lock(&mutex_);
+  busy = (jobSolver_!=NULL);
+  pthread_mutex_unlock(&mutex_);
+#endif
+  return busy;
+}
+
+void DcoHeurExecutor::wait() {
+#if defined(DISCO_THREADS)
+  pthread_mutex_lock(&mutex_);
+  while (jobSolver_) {
+    pthread_cond_wait(&doneCond_, &mutex_);
+  }
+  pthread_mutex_unlock(&mutex_);
+#endif
+}
+
+DcoSolution * DcoHeurExecutor::popSolution(DcoHeuristic *& finder) {
+  DcoSolution * sol = NULL;
+  finder = NULL;
+  lock();
+  if (!solutions_.empty()) {
+    sol = solutions_.front();
+    finder = finders_.front();
+    solutions_.pop();
+    finders_.pop();
+  }
+  unlock();
+  return sol;
+}
@@ -0,0 +1,148 @@
+#ifndef DcoHeurExecutor_hpp_
+#define DcoHeurExecutor_hpp_
+
+// STL headers
+#include <queue>
+
+// Disco headers
+#include "Dco.hpp"
+
+#if defined(DISCO_THREADS)
+#include <pthread.h>
+#endif
+
+class DcoModel;
+class DcoSolution;
+class DcoHeuristic;
+class CoinMessageHandler;
+class OsiSolverInterface;
+class OsiConicSolverInterface;
+
+/*!
+  Runs heuristics of the model on a background thread.
+
+  submit() takes a snapshot of the node subproblem, the solver is cloned and
+  the current LP solution is copied into the clone. The clone carries the
+  node bounds and cuts. Worker thread runs every heuristic of the model on the
+  clone and pushes the solutions it finds into a queue. Node processing does
+  not wait for the worker, it drains the queue with popSolution() and passes
+  the solutions to the broker.
+
+  Only one snapshot is processed at a time. If the worker is busy when a new
+  snapshot is submitted, the snapshot is dropped. Heuristics are owned by the
+  model, while the executor is alive they should not be called from the main
+  thread.
+
+  Heuristic call frequencies, work limits and statistics are changed by the
+  worker and read by submit(), both access them holding the mutex. Worker
+  logs through its own copy of the model's message handler since
+  CoinMessageHandler is not thread safe.
+
+  When threads are not available (MSVC builds) submit() runs the heuristics in
+  the calling thread and the solutions are queued the same way.
+*/
+
+class DcoHeurExecutor {
+  /// Pointer to the model.
+  DcoModel * model_;
+  /// Message handler of the worker, a copy of the model's handler.
+  CoinMessageHandler * messageHandler_;
+  /// Solver clone of the current job, NULL when there is no job.
+#if defined(__OA__)
+  OsiSolverInterface * jobSolver_;
+#else
+  OsiConicSolverInterface * jobSolver_;
+#endif
+  /// Solutions found by the worker, waiting to be drained.
+  std::queue<DcoSolution*> solutions_;
+  /// Heuristics that found the solutions in #solutions_, in the same order.
+  std::queue<DcoHeuristic*> finders_;
+  /// Number of snapshots submitted.
+  int numJobs_;
+  /// Number of snapshots dropped since the worker was busy.
+  int numDropped_;
+  /// Index of the node the current job is taken from.
+  int jobIndex_;
+  /// Average node processing time when the current job is submitted.
+  double jobNodeTime_;
+  /// true when worker thread should exit.
+  bool stop_;
+#if defined(DISCO_THREADS)
+  /// Worker thread.
+  pthread_t thread_;
+  /// Guards every field above but #messageHandler_, and the schedules and
+  /// statistics of the heuristics.
+  pthread_mutex_t mutex_;
+  /// Signals a new job or stop request to the worker.
+  pthread_cond_t jobCond_;
+  /// Signals the end of a job to waiting threads.
+  pthread_cond_t doneCond_;
+  /// Entry point of worker thread, arg is the executor.
+  static void * workerEntry(void * arg);
+#endif
+  ///@name Lock and unlock the mutex, they do nothing without threads.
+  //@{
+  void lock();
+  void unlock();
+  //@}
+  /// Worker loop, waits for jobs and runs them until stop_ is set.
+  void workerLoop();
+  /// Run heuristics of the model on the given solver and queue the
+  /// solutions. Called without holding the mutex, the mutex is held only
+  /// while the heuristic schedules and statistics are accessed.
+#if defined(__OA__)
+  void runHeuristics(OsiSolverInterface * solver);
+#else
+  void runHeuristics(OsiConicSolverInterface * solver);
+#endif
+  /// Push a solution found by heuristic to the queue.
+  void pushSolution(DcoHeuristic * heur, DcoSolution * sol);
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor, starts the worker thread.
+  DcoHeurExecutor(DcoModel * model);
+  /// Destructor. Stops and joins the worker thread, frees the solutions that
+  /// are not drained. DcoModel::collectHeuristicSolutions() drains them at
+  /// the end of the search.
+  ~DcoHeurExecutor();
+  //@}
+
+  ///@name Interface to node processing.
+  //@{
+  /// Submit a snapshot of the given solver taken at node nodeIndex. Returns
+  /// false if the worker is busy or none of the heuristics should be called
+  /// at this node, snapshot is dropped in these cases. nodeTime is the
+  /// average node processing time in wall clock seconds, heuristic times
+  /// are measured in wall clock too. It is used to adapt heuristic call
+  /// frequencies.
+#if defined(__OA__)
+  bool submit(OsiSolverInterface const * solver, int nodeIndex,
+              double nodeTime);
+#else
+  bool submit(OsiConicSolverInterface const * solver, int nodeIndex,
+              double nodeTime);
+#endif
+  /// Returns true if worker is processing a snapshot.
+  bool busy();
+  /// Block until the worker finishes the current snapshot.
+  void wait();
+  /// Pop a solution from the queue, returns NULL if queue is empty. Caller
+  /// owns the solution. finder is set to the heuristic that found it.
+  DcoSolution * popSolution(DcoHeuristic *& finder);
+  /// Number of snapshots submitted.
+  int numJobs() const { return numJobs_; }
+  /// Number of snapshots dropped.
+  int numDropped() const { return numDropped_; }
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoHeurExecutor();
+  /// Disable copy constructor.
+  DcoHeurExecutor(DcoHeurExecutor const & other);
+  /// Disable copy assignment operator.
+  DcoHeurExecutor & operator=(DcoHeurExecutor const & rhs);
+};
+
+#endif
@@ -0,0 +1,358 @@
+#include "DcoHeurLocalSearch.hpp"
+#include "DcoModel.hpp"
+#include "DcoSolution.hpp"
+#include "DcoLinearConstraint.hpp"
+#include "DcoConicConstraint.hpp"
+
+#include <AlpsKnowledgeBroker.h>
+#include <CoinPackedMatrix.hpp>
+
+#include <cmath>
+
+DcoHeurLocalSearch::DcoHeurLocalSearch(DcoModel * model, char const * name,
+                                       DcoHeurStrategy strategy,
+                                       int frequency)
+  : DcoHeuristic(model, name, strategy, frequency) {
+  setType(DcoHeurTypeLocalSearch);
+  matrix_ = NULL;
+}
+
+DcoHeurLocalSearch::~DcoHeurLocalSearch() {
+  if (matrix_) {
+    delete matrix_;
+    matrix_ = NULL;
+  }
+}
+
+void DcoHeurLocalSearch::setupData() {
+  if (matrix_) {
+    return;
+  }
+  DcoModel * m = model();
+  int numCols = m->getNumCoreVariables();
+  int numRows = m->getNumCoreLinearConstraints();
+  int numCones = m->getNumCoreConicConstraints();
+  std::vector<BcpsConstraint*> & rows = m->getConstraints();
+  // linear rows, core linear constraints come first.
+  CoinPackedMatrix row_matrix(false, 0.0, 0.0);
+  row_matrix.setDimensions(0, numCols);
+  for (int i=0; i<numRows; ++i) {
+    DcoLinearConstraint * con = dynamic_cast<DcoLinearConstraint*>(rows[i]);
+    row_matrix.appendRow(con->getSize(), con->getIndices(),
+                         con->getValues());
+  }
+  matrix_ = new CoinPackedMatrix();
+  matrix_->reverseOrderedCopyOf(row_matrix);
+  // cone membership of columns
+  cones_.resize(numCones);
+  colConeStart_.assign(numCols+1, 0);
+  for (int k=0; k<numCones; ++k) {
+    cones_[k] = dynamic_cast<DcoConicConstraint*>(rows[numRows+k]);
+    int const * members = cones_[k]->coneMembers();
+    for (int j=0; j<cones_[k]->coneSize(); ++j) {
+      colConeStart_[members[j]+1]++;
+    }
+  }
+  for (int i=0; i<numCols; ++i) {
+    colConeStart_[i+1] += colConeStart_[i];
+  }
+  colCones_.resize(colConeStart_[numCols]);
+  std::vector<int> pos(colConeStart_.begin(), colConeStart_.end()-1);
+  for (int k=0; k<numCones; ++k) {
+    int const * members = cones_[k]->coneMembers();
+    for (int j=0; j<cones_[k]->coneSize(); ++j) {
+      colCones_[pos[members[j]]++] = k;
+    }
+  }
+}
+
+double DcoHeurLocalSearch::coneSumSquares(int k) const {
+  DcoConicConstraint const * con = cones_[k];
+  int const * members = con->coneMembers();
+  int num_lead = (con->coneType()==DcoRotatedLorentzCone) ? 2 : 1;
+  double ss = 0.0;
+  for (int j=num_lead; j<con->coneSize(); ++j) {
+    ss += x_[members[j]]*x_[members[j]];
+  }
+  return ss;
+}
+
+double DcoHeurLocalSearch::coneInfeasibility(int k, int num,
+                                             int const * cols,
+                                             double const * deltas) const {
+  DcoConicConstraint const * con = cones_[k];
+  int const * members = con->coneMembers();
+  int size = con->coneSize();
+  bool rotated = (con->coneType()==DcoRotatedLorentzCone);
+  int num_lead = rotated ? 2 : 1;
+  double ss = coneSS_[k];
+  double x1 = x_[members[0]];
+  double x2 = rotated ? x_[members[1]] : 0.0;
+  for (int i=0; i<num; ++i) {
+    int col = cols[i];
+    if (col==members[0]) {
+      x1 += deltas[i];
+    }
+    else if (rotated and col==members[1]) {
+      x2 += deltas[i];
+    }
+    else {
+      for (int j=num_lead; j<size; ++j) {
+        if (members[j]==col) {
+          double value = x_[col];
+          ss += (value+deltas[i])*(value+deltas[i]) - value*value;
+        }
+      }
+    }
+  }
+  // same measure as DcoConicConstraint::infeasibility()
+  if (rotated) {
+    return ss - 2.0*x1*x2;
+  }
+  return sqrt(CoinMax(ss, 0.0)) - x1;
+}
+
+bool DcoHeurLocalSearch::feasibleMove(int num, int const * cols,
+                                      double const * deltas) {
+  DcoModel * m = model();
+  std::vector<BcpsVariable*> & vars = m->getVariables();
+  double const * rowLB = m->rowLB();
+  double const * rowUB = m->rowUB();
+  double cone_tol = m->dcoPar()->entry(DcoParams::coneTol);
+  double primal_tol;
+  solver()->getDblParam(OsiPrimalTolerance, primal_tol);
+  // column bounds
+  for (int i=0; i<num; ++i) {
+    double value = x_[cols[i]] + deltas[i];
+    if (value<vars[cols[i]]->getLbHard()-primal_tol or
+        value>vars[cols[i]]->getUbHard()+primal_tol) {
+      return false;
+    }
+  }
+  // linear rows, accumulate activity changes in rowDelta_
+  int const * start = matrix_->getVectorStarts();
+  int const * length = matrix_->getVectorLengths();
+  int const * rowInd = matrix_->getIndices();
+  double const * element = matrix_->getElements();
+  std::vector<int> touched;
+  for (int i=0; i<num; ++i) {
+    int col = cols[i];
+    for (int j=start[col]; j<start[col]+length[col]; ++j) {
+      if (rowDelta_[rowInd[j]]==0.0) {
+        touched.push_back(rowInd[j]);
+      }
+      rowDelta_[rowInd[j]] += element[j]*deltas[i];
+    }
+  }
+  bool feasible = true;
+  for (unsigned int i=0; i<touched.size(); ++i) {
+    int row = touched[i];
+    double activity = activity_[row] + rowDelta_[row];
+    if (activity<rowLB[row]-primal_tol or activity>rowUB[row]+primal_tol) {
+      feasible = false;
+    }
+    rowDelta_[row] = 0.0;
+  }
+  if (!feasible) {
+    return false;
+  }
+  // cones
+  for (int i=0; i<num; ++i) {
+    int col = cols[i];
+    for (int j=colConeStart_[col]; j<colConeStart_[col+1]; ++j) {
+      if (coneInfeasibility(colCones_[j], num, cols, deltas)>cone_tol) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void DcoHeurLocalSearch::applyMove(int num, int const * cols,
+                                   double const * deltas) {
+  int const * start = matrix_->getVectorStarts();
+  int const * length = matrix_->getVectorLengths();
+  int const * rowInd = matrix_->getIndices();
+  double const * element = matrix_->getElements();
+  for (int i=0; i<num; ++i) {
+    int col = cols[i];
+    for (int j=start[col]; j<start[col]+length[col]; ++j) {
+      activity_[rowInd[j]] += element[j]*deltas[i];
+    }
+    x_[col] += deltas[i];
+  }
+  // recompute sums of squares of the cones moved, updating them
+  // incrementally would accumulate round off errors.
+  for (int i=0; i<num; ++i) {
+    int col = cols[i];
+    for (int j=colConeStart_[col]; j<colConeStart_[col+1]; ++j) {
+      coneSS_[colCones_[j]] = coneSumSquares(colCones_[j]);
+    }
+  }
+}
+
+double DcoHeurLocalSearch::maxStep(int col, double dir) const {
+  DcoModel * m = model();
+  BcpsVariable * var = m->getVariables()[col];
+  double const * rowLB = m->rowLB();
+  double const * rowUB = m->rowUB();
+  double primal_tol;
+  solver()->getDblParam(OsiPrimalTolerance, primal_tol);
+  double step = (dir>0.0) ? var->getUbHard() - x_[col] :
+    x_[col] - var->getLbHard();
+  int const * start = matrix_->getVectorStarts();
+  int const * length = matrix_->getVectorLengths();
+  int const * rowInd = matrix_->getIndices();
+  double const * element = matrix_->getElements();
+  for (int j=start[col]; j<start[col]+length[col]; ++j) {
+    int row = rowInd[j];
+    double change = dir*element[j];
+    if (change>0.0) {
+      step = CoinMin(step, (rowUB[row]+primal_tol-activity_[row])/change);
+    }
+    else if (change<0.0) {
+      step = CoinMin(step, (activity_[row]-rowLB[row]+primal_tol)/(-change));
+    }
+  }
+  // notes(aykut) columns that are not bounded by rows are bounded by the
+  // cones or not at all, cap the step, caller halves it until the cones
+  // are feasible.
+  step = CoinMin(step, 1.0e6);
+  return floor(step + 1.0e-9);
+}
+
+double DcoHeurLocalSearch::pairMove(int col, double dir) {
+  DcoModel * m = model();
+  std::vector<BcpsVariable*> & vars = m->getVariables();
+  std::vector<BcpsConstraint*> & rows = m->getConstraints();
+  double const * rowLB = m->rowLB();
+  double const * rowUB = m->rowUB();
+  double const * obj = solver()->getObjCoefficients();
+  double primal_tol;
+  solver()->getDblParam(OsiPrimalTolerance, primal_tol);
+  int const * start = matrix_->getVectorStarts();
+  int const * length = matrix_->getVectorLengths();
+  int const * rowInd = matrix_->getIndices();
+  double const * element = matrix_->getElements();
+  int cols[2];
+  double deltas[2];
+  cols[0] = col;
+  deltas[0] = dir;
+  for (int j=start[col]; j<start[col]+length[col]; ++j) {
+    int row = rowInd[j];
+    double activity = activity_[row] + dir*element[j];
+    if (activity>=rowLB[row]-primal_tol and
+        activity<=rowUB[row]+primal_tol) {
+      // this row does not block the move
+      continue;
+    }
+    // try to repair the row with another integer column of it
+    DcoLinearConstraint * con = dynamic_cast<DcoLinearConstraint*>(rows[row]);
+    int const * indices = con->getIndices();
+    for (int k=0; k<con->getSize(); ++k) {
+      int other = indices[k];
+      if (other==col or vars[other]->getIntType()!='I') {
+        continue;
+      }
+      for (int d=-1; d<=1; d+=2) {
+        double change = obj[col]*dir + obj[other]*d;
+        if (change>=-1.0e-6) {
+          continue;
+        }
+        cols[1] = other;
+        deltas[1] = d;
+        if (feasibleMove(2, cols, deltas)) {
+          applyMove(2, cols, deltas);
+          return change;
+        }
+      }
+    }
+  }
+  return 0.0;
+}
+
+DcoSolution * DcoHeurLocalSearch::searchSolution() {
+  AlpsKnowledgeBroker * broker = model()->broker_;
+  if (!broker->hasKnowledge(AlpsKnowledgeTypeSolution)) {
+    return NULL;
+  }
+  DcoSolution * incumbent = dynamic_cast<DcoSolution*>
+    (broker->getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+  return improveSolution(incumbent);
+}
+
+DcoSolution * DcoHeurLocalSearch::improveSolution(DcoSolution const * sol) {
+  if (strategy() == DcoHeurStrategyNone) {
+    // This heuristic has been disabled.
+    return NULL;
+  }
+  setupData();
+  DcoModel * m = model();
+  int numCols = m->getNumCoreVariables();
+  int numRows = m->getNumCoreLinearConstraints();
+  int numIntegers = m->numIntegerCols();
+  int const * integerCols = m->integerCols();
+  double const * obj = solver()->getObjCoefficients();
+  // initialize the search state at sol
+  double const * values = sol->getValues();
+  x_.assign(values, values+numCols);
+  activity_.assign(numRows, 0.0);
+  rowDelta_.assign(numRows, 0.0);
+  int const * start = matrix_->getVectorStarts();
+  int const * length = matrix_->getVectorLengths();
+  int const * rowInd = matrix_->getIndices();
+  double const * element = matrix_->getElements();
+  for (int i=0; i<numCols; ++i) {
+    if (x_[i]==0.0) {
+      continue;
+    }
+    for (int j=start[i]; j<start[i]+length[i]; ++j) {
+      activity_[rowInd[j]] += element[j]*x_[i];
+    }
+  }
+  coneSS_.resize(cones_.size());
+  for (unsigned int k=0; k<cones_.size(); ++k) {
+    coneSS_[k] = coneSumSquares(k);
+  }
+  // passes over integer columns until no improving move is found
+  double obj_change = 0.0;
+  for (int pass=0; pass<workLimit(); ++pass) {
+    double pass_change = 0.0;
+    for (int i=0; i<numIntegers; ++i) {
+      int col = integerCols[i];
+      if (obj[col]==0.0) {
+        continue;
+      }
+      double dir = (obj[col]>0.0) ? -1.0 : 1.0;
+      // 1-opt, largest step the rows allow, halved until cones allow it.
+      double step = maxStep(col, dir);
+      double delta = 0.0;
+      while (step>=1.0) {
+        delta = dir*step;
+        if (feasibleMove(1, &col, &delta)) {
+          break;
+        }
+        step = floor(step/2.0);
+      }
+      if (step>=1.0) {
+        applyMove(1, &col, &delta);
+        pass_change += obj[col]*delta;
+      }
+      else {
+        // 2-opt
+        pass_change += pairMove(col, dir);
+      }
+    }
+    obj_change += pass_change;
+    if (pass_change>-1.0e-6) {
+      break;
+    }
+  }
+  DcoSolution * dco_sol = NULL;
+  if (obj_change<-1.0e-6) {
+    dco_sol = new DcoSolution(numCols, &x_[0],
+                              sol->getQuality()+obj_change);
+    dco_sol->setBroker(model()->broker_);
+  }
+  return dco_sol;
+}
@@ -0,0 +1,109 @@
+#ifndef DcoHeurLocalSearch_hpp_
+#define DcoHeurLocalSearch_hpp_
+
+// STL headers
+#include <vector>
+
+// Disco headers
+#include "DcoHeuristic.hpp"
+
+class CoinPackedMatrix;
+class DcoConicConstraint;
+
+/*!
+  Improvement heuristic, searches the neighborhood of a feasible solution.
+
+  Continuous columns are kept at their values and integer columns are moved
+  in the direction that decreases the objective.
+
+  <ul>
+  <li> 1-opt: an integer column is moved by the largest integral step that
+  keeps the column bounds, the linear rows and the cones feasible.
+  <li> 2-opt: when 1-opt can not move a column since a linear row blocks
+  it, the column is moved by 1 together with another integer column of the
+  blocking row that is moved by 1, if the pair decreases the objective.
+  </ul>
+
+  Row activities are updated incrementally with the column copy of the
+  linear rows. Cones are checked analytically, sum of squares of the
+  non-leading members of every cone is kept and updated with the move.
+
+  The heuristic is not called at nodes, DcoModel::storeSolution() calls
+  improveSolution() for every new incumbent before it is stored. Work limit
+  is the number of passes over integer columns.
+*/
+
+class DcoHeurLocalSearch: virtual public DcoHeuristic {
+  ///@name Problem data, built at the first call.
+  //@{
+  /// Column ordered copy of the core linear rows.
+  CoinPackedMatrix * matrix_;
+  /// Cones each column is a member of, cones of column i are in
+  /// [colConeStart_[i], colConeStart_[i+1]) of colCones_.
+  std::vector<int> colConeStart_;
+  std::vector<int> colCones_;
+  /// Core conic constraints of the model.
+  std::vector<DcoConicConstraint const *> cones_;
+  //@}
+
+  ///@name State of the current search.
+  //@{
+  /// Current point.
+  std::vector<double> x_;
+  /// Activity of the linear rows at x_.
+  std::vector<double> activity_;
+  /// Sum of squares of the non-leading members of every cone at x_.
+  std::vector<double> coneSS_;
+  /// Scratch space for row activity changes of a move, all zeros between
+  /// moves.
+  std::vector<double> rowDelta_;
+  //@}
+
+  /// Build matrix_ and cone membership lists.
+  void setupData();
+  /// Compute sum of squares of the non-leading members of cone k at x_.
+  double coneSumSquares(int k) const;
+  /// Infeasibility of cone k after cols[i] are changed by deltas[i].
+  double coneInfeasibility(int k, int num, int const * cols,
+                           double const * deltas) const;
+  /// Check whether changing cols[i] by deltas[i] keeps the bounds, the
+  /// linear rows and the cones feasible.
+  bool feasibleMove(int num, int const * cols, double const * deltas);
+  /// Apply the move to x_, activity_ and coneSS_.
+  void applyMove(int num, int const * cols, double const * deltas);
+  /// Largest integral step of column col in direction dir allowed by its
+  /// bounds and the linear rows.
+  double maxStep(int col, double dir) const;
+  /// Try 2-opt moves for column col that is blocked in direction dir.
+  /// Returns the objective change of the applied move, 0.0 if there is none.
+  double pairMove(int col, double dir);
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoHeurLocalSearch(DcoModel * model, char const * name,
+                     DcoHeurStrategy strategy, int frequency);
+  /// Destructor.
+  virtual ~DcoHeurLocalSearch();
+  //@}
+
+  ///@name Finding solutions.
+  //@{
+  /// Improve the incumbent of the broker, returns NULL if there is no
+  /// incumbent or it can not be improved.
+  virtual DcoSolution * searchSolution();
+  /// Improve the given feasible solution. Returns the improved solution or
+  /// NULL if no improving move is found. Caller owns the returned solution.
+  DcoSolution * improveSolution(DcoSolution const * sol);
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoHeurLocalSearch();
+  /// Disable copy constructor.
+  DcoHeurLocalSearch(const DcoHeurLocalSearch & other);
+  /// Disable copy assignment operator
+  DcoHeurLocalSearch & operator=(const DcoHeurLocalSearch & rhs);
+};
+
+#endif
@@ -22,27 +22,21 @@ DcoSolution * DcoHeurRounding::searchSolution() {
     // This heuristic has been disabled.
     return NULL;
   }
-  else if (strategy() == DcoHeurStrategyAuto) {
-    // todo(aykut) the disable threshold should be a parameter in DcoParams.
-    int disable_threshold = 1000000;
-    if (stats().numNoSolCalls() > disable_threshold) {
-      return NULL;
-    }
-  }
+  // notes(aykut) auto strategy is handled by the caller through shouldCall()
+  // and adapt(), we only respect the work limit here.
   DcoSolution * dco_sol = NULL;
   // get pointers for message logging
-  CoinMessageHandler * message_handler = model()->dcoMessageHandler_;
+  CoinMessageHandler * message_handler = messageHandler();
   CoinMessages * messages = model()->dcoMessages_;
 
   // Get a copy of original matrix (and by row for rounding);
-  CoinPackedMatrix const * matrix = model()->solver()->getMatrixByCol();
-  CoinPackedMatrix const * matrixByRow = model()->solver()->getMatrixByRow();
-
 #if defined(__OA__)
-  OsiSolverInterface * solver = model()->solver();
+  OsiSolverInterface * solver = DcoHeuristic::solver();
 #else
-  OsiConicSolverInterface * solver = model()->solver();
+  OsiConicSolverInterface * solver = DcoHeuristic::solver();
 #endif
+  CoinPackedMatrix const * matrix = solver->getMatrixByCol();
+  CoinPackedMatrix const * matrixByRow = solver->getMatrixByRow();
   double const * colLower = solver->getColLower();
   double const * colUpper = solver->getColUpper();
   double const * rowLower = solver->getRowLower();
@@ -230,11 +224,9 @@ DcoSolution * DcoHeurRounding::searchSolution() {
   // Could also set SOS (using random) and repeat
   if (!penalty) {
     // Got a feasible solution. Try to improve.
-    //seed_++;
-    //CoinSeedRandom(seed_);
-    // Random number between 0 and 1.
-
-    double randomNumber = CoinDrand48();
+    // Random number between 0 and 1. Use our own generator, CoinDrand48()
+    // has a global state and we may run on the heuristic thread.
+    double randomNumber = random_.randomDouble();
     int start[2];
     int end[2];
     int iRandom = (int) (randomNumber * ((double) numIntegers));
@@ -242,53 +234,59 @@ DcoSolution * DcoHeurRounding::searchSolution() {
     end[0] = numIntegers;
     start[1] = 0;
     end[1] = iRandom;
-    // todo(aykut) number of passes is a parameter, use it. set default value
-    // to 2.
-    for (int iPass = 0; iPass<2; iPass++) {
-      for (int i=start[iPass]; i<end[iPass]; i++) {
-        int iColumn = integerCols[i];
+    // Each sweep makes two passes over the integer columns starting from a
+    // random one. Number of sweeps is the work limit, we stop early when a
+    // sweep does not move any column.
+    bool moved = true;
+    for (int sweep=0; sweep<workLimit() and moved; ++sweep) {
+      moved = false;
+      for (int iPass = 0; iPass<2; iPass++) {
+        for (int i=start[iPass]; i<end[iPass]; i++) {
+          int iColumn = integerCols[i];
 #ifdef DISCO_DEBUG
-        double value = sol[iColumn];
-        assert(fabs(floor(value + 0.5) - value) < integerTol);
+          double value = sol[iColumn];
+          assert(fabs(floor(value + 0.5) - value) < integerTol);
 #endif
-        double cost = direction * obj[iColumn];
-        double move = 0.0;
-        if (cost > 0.0)
-          move = -1.0;
-        else if (cost < 0.0)
-          move = 1.0;
-        while (move) {
-          bool good = true;
-          double newValue = sol[iColumn] + move;
-          if (newValue < colLower[iColumn] - primalTolerance||
-              newValue > colUpper[iColumn] + primalTolerance) {
-            move = 0.0;
-          }
-          else {
-            // see if we can move
-            for (int j=columnStart[iColumn];
-                 j<columnStart[iColumn]+columnLength[iColumn]; j++) {
-              int iRow = row[j];
-              double newActivity =
-                rowActivity[iRow] + move*element[j];
-              if (newActivity < rowLower[iRow] - primalTolerance
-                  ||
-                  newActivity > rowUpper[iRow]+primalTolerance) {
-                good = false;
-                break;
-              }
+          double cost = direction * obj[iColumn];
+          double move = 0.0;
+          if (cost > 0.0)
+            move = -1.0;
+          else if (cost < 0.0)
+            move = 1.0;
+          while (move) {
+            bool good = true;
+            double newValue = sol[iColumn] + move;
+            if (newValue < colLower[iColumn] - primalTolerance||
+                newValue > colUpper[iColumn] + primalTolerance) {
+              move = 0.0;
             }
-            if (good) {
-              sol[iColumn] = newValue;
-              sol_quality += move * cost;
+            else {
+              // see if we can move
               for (int j=columnStart[iColumn];
                    j<columnStart[iColumn]+columnLength[iColumn]; j++) {
                 int iRow = row[j];
-                rowActivity[iRow] += move*element[j];
+                double newActivity =
+                  rowActivity[iRow] + move*element[j];
+                if (newActivity < rowLower[iRow] - primalTolerance
+                    ||
+                    newActivity > rowUpper[iRow]+primalTolerance) {
+                  good = false;
+                  break;
+                }
+              }
+              if (good) {
+                moved = true;
+                sol[iColumn] = newValue;
+                sol_quality += move * cost;
+                for (int j=columnStart[iColumn];
+                     j<columnStart[iColumn]+columnLength[iColumn]; j++) {
+                  int iRow = row[j];
+                  rowActivity[iRow] += move*element[j];
+                }
+              }
+              else {
+                move=0.0;
               }
-            }
-            else {
-              move=0.0;
             }
           }
         }
@@ -364,14 +362,9 @@ DcoSolution * DcoHeurRounding::searchSolution() {
       // new solution found, store solution.
       dco_sol = new DcoSolution(numCols, sol, sol_quality);
       dco_sol->setBroker(model()->broker_);
-      stats().addNumSolutions();
-    }
-    else {
-      // update statistics
-      stats().addNoSolCalls();
-      // Can easily happen
-      //printf("Debug DcoHeurRound giving bad solution\n");
     }
+    // Can easily happen
+    //printf("Debug DcoHeurRound giving bad solution\n");
   }
   delete [] sol;
   delete [] rowActivity;
@@ -406,29 +399,29 @@ DcoSolution * DcoHeurRounding::searchSolution2() {
 void DcoHeurRounding::bound_fix(int * down_fix, int * up_fix) {
   DcoModel * dcom = model();
   // get required pointers for log messages
-  CoinMessageHandler * message_handler = dcom->dcoMessageHandler_;
+  CoinMessageHandler * message_handler = messageHandler();
   //CoinMessages * messages = dcom->dcoMessages_;
 
-  int num_rows = dcom->solver()->getNumRows();
-  char const * row_sense = dcom->solver()->getRowSense();
+  int num_rows = solver()->getNumRows();
+  char const * row_sense = solver()->getRowSense();
 
-  double infinity = dcom->solver()->getInfinity();
+  double infinity = solver()->getInfinity();
   // iterate over rows and update up and down fixed.
   for (int i=0; i<num_rows; ++i) {
     if (row_sense[i]=='R') {
-      if (dcom->solver()->getColUpper()[i]>=infinity
-          and dcom->solver()->getColLower()[i]<=-infinity) {
+      if (solver()->getColUpper()[i]>=infinity
+          and solver()->getColLower()[i]<=-infinity) {
         // both upper and lower bound are not finite,
         // do nothing
         continue;
       }
       // upper bound is infinity
-      if (dcom->solver()->getColUpper()[i]>=infinity) {
+      if (solver()->getColUpper()[i]>=infinity) {
         bound_fix2('G', i, down_fix, up_fix);
         continue;
       }
       // lower bound is negative infinity
-      if (dcom->solver()->getColLower()[i]<=-infinity) {
+      if (solver()->getColLower()[i]<=-infinity) {
         bound_fix2('L', i, down_fix, up_fix);
         continue;
       }
@@ -457,9 +450,9 @@ void DcoHeurRounding::bound_fix(int * down_fix, int * up_fix) {
 }
 
 void DcoHeurRounding::bound_fix2(char sense, int row_index, int * down_fix, int * up_fix) {
-  //char row_sense = dcom->solver()->getRowSense()[row_index];
+  //char row_sense = solver()->getRowSense()[row_index];
 
-  CoinPackedMatrix const * matrix = model()->solver()->getMatrixByRow();
+  CoinPackedMatrix const * matrix = solver()->getMatrixByRow();
   int const * indices = matrix->getIndices();
   double const * values = matrix->getElements();
   int const * lengths = matrix->getVectorLengths();
@@ -477,8 +470,7 @@ void DcoHeurRounding::bound_fix2(char sense, int row_index, int * down_fix, int
               << " is "
               << values[i]
               << ", very close to 0.";
-      model()->dcoMessageHandler_->message(3000, "Dco", warning.str().c_str(),
-                                           'W', 0)
+      messageHandler()->message(3000, "Dco", warning.str().c_str(), 'W', 0)
         << CoinMessageEol;
     }
     if (sense=='E') {
@@ -506,8 +498,7 @@ void DcoHeurRounding::bound_fix2(char sense, int row_index, int * down_fix, int
       std::stringstream error;
       error << "Unexpected row sense "
             << sense;
-      model()->dcoMessageHandler_->message(9998, "Dco", error.str().c_str(),
-                                           'E', 0)
+      messageHandler()->message(9998, "Dco", error.str().c_str(), 'E', 0)
         << CoinMessageEol;
     }
   }
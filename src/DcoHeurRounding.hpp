@@ -1,6 +1,9 @@
 #ifndef DcoHeurRounding_hpp_
 #define DcoHeurRounding_hpp_
 
+// CoinUtils headers
+#include <CoinHelperFunctions.hpp>
+
 // Disco headers
 #include "DcoHeuristic.hpp"
 
@@ -14,6 +17,8 @@
 
 /** Heuristic base class */
 class DcoHeurRounding: virtual public DcoHeuristic {
+  /// Random number generator, picks the column rounding passes start from.
+  CoinThreadRandom random_;
   void bound_fix(int * down_fix, int * up_fix);
   void bound_fix2(char sense, int row_index, int * down_fix, int * up_fix);
 public:
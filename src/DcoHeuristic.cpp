@@ -1,10 +1,27 @@
 #include "DcoHeuristic.hpp"
+#include "DcoModel.hpp"
+
+#include <CoinHelperFunctions.hpp>
+
+#include <cmath>
 
 void DcoHeurStats::reset() {
   numCalls_ = 0;
   numNoSolCalls_ = 0;
   time_ = 0.0;
   numSolutions_ = 0;
+  numNoSolStreak_ = 0;
+}
+
+void DcoHeurStats::addCall(double t, bool found) {
+  addTime(t);
+  addCalls(1);
+  if (found) {
+    addNumSolutions(1);
+  }
+  else {
+    addNoSolCalls(1);
+  }
 }
 
 DcoHeuristic::DcoHeuristic(DcoModel * model, char const * name,
@@ -14,6 +31,92 @@ DcoHeuristic::DcoHeuristic(DcoModel * model, char const * name,
   name_ = name;
   strategy_ = strategy;
   frequency_ = frequency;
+  if (strategy_==DcoHeurStrategyAuto) {
+    // start calling at every node, adapt() will space the calls out.
+    frequency_ = 1;
+  }
+  workLimit_ = 1;
+  maxWorkLimit_ = 4;
   type_ = DcoHeurTypeNotSet;
+  solver_ = NULL;
+  messageHandler_ = NULL;
   stats_.reset();
 }
+
+#if defined(__OA__)
+OsiSolverInterface * DcoHeuristic::solver() const {
+#else
+OsiConicSolverInterface * DcoHeuristic::solver() const {
+#endif
+  if (solver_) {
+    return solver_;
+  }
+  return model_->solver();
+}
+
+CoinMessageHandler * DcoHeuristic::messageHandler() const {
+  if (messageHandler_) {
+    return messageHandler_;
+  }
+  return model_->dcoMessageHandler_;
+}
+
+void DcoHeuristic::setWorkLimit(int limit) {
+  workLimit_ = CoinMax(limit, 1);
+  maxWorkLimit_ = 4*workLimit_;
+}
+
+bool DcoHeuristic::shouldCall(int nodeIndex) const {
+  bool do_call = false;
+  switch (strategy_) {
+  case DcoHeurStrategyNone:
+  case DcoHeurStrategyBeforeRoot:
+    do_call = false;
+    break;
+  case DcoHeurStrategyRoot:
+    do_call = (nodeIndex==0);
+    break;
+  case DcoHeurStrategyAuto:
+  case DcoHeurStrategyPeriodic:
+    do_call = (frequency_ > 0 and nodeIndex % frequency_ == 0);
+    break;
+  default:
+    do_call = false;
+  }
+  return do_call;
+}
+
+/*
+  Success per time rule. Let s be the success rate of the heuristic (with
+  Laplace smoothing) and c the average cost of a call measured in nodes. A
+  heuristic with 50% or better success rate is allowed to use share of the
+  node processing time, a heuristic that keeps failing gets a proportionally
+  smaller share. Calling every f nodes costs c/f of a node, so
+
+  f = ceil(c / (share * min(1, 2s)))
+
+  Work limit doubles when the last call found a solution and halves after
+  every 10 consecutive calls without a solution.
+*/
+void DcoHeuristic::adapt(double nodeTime) {
+  if (strategy_!=DcoHeurStrategyAuto or stats_.numCalls()==0) {
+    return;
+  }
+  double time_share = model_->dcoPar()->entry(DcoParams::heurAutoTimeShare);
+  int max_freq = model_->dcoPar()->entry(DcoParams::heurAutoMaxFreq);
+  double success = (stats_.numSolutions() + 1.0) / (stats_.numCalls() + 2.0);
+  double cost = stats_.time() / stats_.numCalls();
+  cost = cost / CoinMax(nodeTime, 1.0e-6);
+  double share = time_share * CoinMin(1.0, 2.0*success);
+  double freq = ceil(cost / CoinMax(share, 1.0e-6));
+  frequency_ = static_cast<int>(CoinMin(freq, double(max_freq)));
+  frequency_ = CoinMax(frequency_, 1);
+  // adapt work limit
+  int streak = stats_.numNoSolStreak();
+  if (streak==0) {
+    workLimit_ = CoinMin(2*workLimit_, maxWorkLimit_);
+  }
+  else if (streak % 10 == 0) {
+    workLimit_ = CoinMax(workLimit_/2, 1);
+  }
+}
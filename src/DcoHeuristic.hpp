@@ -9,6 +9,9 @@
 
 class DcoModel;
 class DcoSolution;
+class CoinMessageHandler;
+class OsiSolverInterface;
+class OsiConicSolverInterface;
 
 //#############################################################################
 
@@ -26,6 +29,8 @@ class DcoHeurStats {
   double time_;
   // number of solutions found by the heuristic
   int numSolutions_;
+  /// number of calls with no solution since the last solution found.
+  int numNoSolStreak_;
 public:
   ///@name Constructors and Destructors
   //@{
@@ -38,9 +43,11 @@ public:
   ///@name Update statistics
   //@{
   void addCalls(int c=1) { numCalls_ += c; }
-  void addNoSolCalls(int n=1) { numNoSolCalls_ += n; }
+  void addNoSolCalls(int n=1) { numNoSolCalls_ += n; numNoSolStreak_ += n; }
   void addTime(double t) { time_ += t; }
-  void addNumSolutions(int n=1) { numSolutions_ += n; }
+  void addNumSolutions(int n=1) { numSolutions_ += n; numNoSolStreak_ = 0; }
+  /// Record a call that took time t, found is true if it gave a solution.
+  void addCall(double t, bool found);
   /// Reset statistics to 0.
   void reset();
   //@}
@@ -51,6 +58,7 @@ public:
   int numNoSolCalls() const { return numNoSolCalls_; }
   double time() const { return time_; }
   int numSolutions() const { return numSolutions_; }
+  int numNoSolStreak() const { return numNoSolStreak_; }
   //@}
 };
 
@@ -77,8 +85,24 @@ class DcoHeuristic {
   /// The frequency with which to call the heuristic */
   // todo(aykut) isn't this a part of strategy?
   int frequency_;
+  /// Work limit of a single call, its unit is up to the heuristic (passes,
+  /// moves, etc.). Adapted together with frequency_ for auto strategy.
+  int workLimit_;
+  /// Upper bound for workLimit_, 4 times the initial work limit.
+  int maxWorkLimit_;
   /// Statistics.
   DcoHeurStats stats_;
+  /// Solver the heuristic searches on. When NULL model's solver is used. It is
+  /// set to a clone of the model's solver when the heuristic runs in
+  /// #DcoHeurExecutor.
+#if defined(__OA__)
+  OsiSolverInterface * solver_;
+#else
+  OsiConicSolverInterface * solver_;
+#endif
+  /// Message handler the heuristic logs to. When NULL model's handler is
+  /// used. #DcoHeurExecutor sets it to a handler of its own.
+  CoinMessageHandler * messageHandler_;
 public:
   ///@name Constructors and Destructor.
   //@{
@@ -96,14 +120,49 @@ public:
   std::string const & name() const { return name_; }
   DcoHeurStrategy strategy() const { return strategy_; }
   int frequency() const { return frequency_; }
+  int workLimit() const { return workLimit_; }
   DcoHeurStats & stats() { return stats_; }
   DcoHeurStats const & stats() const { return stats_; }
+  /// Get the solver the heuristic should search on.
+#if defined(__OA__)
+  OsiSolverInterface * solver() const;
+#else
+  OsiConicSolverInterface * solver() const;
+#endif
+  /// Get the message handler the heuristic should log to.
+  CoinMessageHandler * messageHandler() const;
   //@}
 
   ///@name Set methods
   //@{
   void setType(DcoHeurType type) { type_ = type; }
+  /// Set work limit of a single call, also sets the largest work limit
+  /// adaptive scheduling can grow it to.
+  void setWorkLimit(int limit);
+  /// Set the solver to search on, NULL resets it to the model's solver.
+  /// Heuristic does not own the solver.
+#if defined(__OA__)
+  void setSolver(OsiSolverInterface * solver) { solver_ = solver; }
+#else
+  void setSolver(OsiConicSolverInterface * solver) { solver_ = solver; }
+#endif
+  /// Set the message handler to log to, NULL resets it to the model's
+  /// handler. Heuristic does not own the handler.
+  void setMessageHandler(CoinMessageHandler * handler) {
+    messageHandler_ = handler;
+  }
   //@}
+  ///@name Scheduling
+  //@{
+  /// Decide whether to call the heuristic at the node with the given index.
+  bool shouldCall(int nodeIndex) const;
+  /// Adapt call frequency and work limit to the observed yield of the
+  /// heuristic. Called after each call. Does nothing unless strategy is
+  /// auto. nodeTime is the average time spent for processing a node, it
+  /// should be measured with the same clock as the heuristic times.
+  void adapt(double nodeTime);
+  //@}
+
   ///@name Finding solutions.
   //@{
   /// returns a solution if found, NULL otherwise.
@@ -0,0 +1,35 @@
+#include "DcoImplications.hpp"
+
+DcoImplications::DcoImplications(int numCols):
+  implied_(2*numCols), numImplications_(0), numTightened_(0) {
+}
+
+DcoImplications::~DcoImplications() {
+}
+
+bool DcoImplications::add(int binary, int value, int col, char sense,
+                          double bound) {
+  std::vector<DcoImpliedBound> & list = implied_[2*binary+value];
+  // lists are short, search linearly
+  for (unsigned int i=0; i<list.size(); ++i) {
+    if (list[i].col==col and list[i].sense==sense) {
+      bool tighter = (sense=='L') ? bound>list[i].bound : bound<list[i].bound;
+      if (tighter) {
+        list[i].bound = bound;
+      }
+      return tighter;
+    }
+  }
+  DcoImpliedBound imp;
+  imp.col = col;
+  imp.sense = sense;
+  imp.bound = bound;
+  list.push_back(imp);
+  numImplications_++;
+  return true;
+}
+
+void DcoImplications::addTightened(int col) {
+  tightened_.push_back(col);
+  numTightened_++;
+}
@@ -0,0 +1,85 @@
+#ifndef DcoImplications_hpp_
+#define DcoImplications_hpp_
+
+#include <vector>
+
+/// Bound of column col implied by a binary column taking a value. sense is
+/// 'L' for a lower bound and 'U' for an upper bound.
+struct DcoImpliedBound {
+  int col;
+  char sense;
+  double bound;
+};
+
+/*!
+  DcoImplications is the model-wide table of what probing learns about the
+  problem. It stores
+
+  <ul>
+  <li> implications, bounds implied by a binary column being fixed to 0 or
+       1, x_b = v => x_j <= u or x_b = v => x_j >= l. They are extracted from
+       probing cuts with two columns found with the global bounds, so they
+       are globally valid. DcoPropagator applies them at the nodes when
+       the binary column is fixed.
+  <li> columns whose global bounds are tightened since the last call to
+       clearTightened(). Bounds themselves are kept in the variables, the
+       list is used to carry the changes to the root node description.
+  </ul>
+
+  For every binary and value only the tightest bound of a column is kept.
+  The table is local to the process, it is not encoded.
+*/
+
+class DcoImplications {
+  /// implied_[2b+v] is the list of bounds implied by x_b = v.
+  std::vector<std::vector<DcoImpliedBound> > implied_;
+  /// Number of implications stored.
+  int numImplications_;
+  /// Columns with tightened global bounds, not synchronized yet.
+  std::vector<int> tightened_;
+  /// Number of global bound changes so far.
+  int numTightened_;
+public:
+  ///@name Constructors and Destructor
+  //@{
+  /// Create an empty table for numCols columns.
+  DcoImplications(int numCols);
+  /// Destructor.
+  ~DcoImplications();
+  //@}
+
+  ///@name Implications
+  //@{
+  /// Record x_binary = value => bound on col. Returns true if the table
+  /// changes, i.e. the implication is new or tighter than the stored one.
+  bool add(int binary, int value, int col, char sense, double bound);
+  /// Get bounds implied by x_binary = value.
+  std::vector<DcoImpliedBound> const & implied(int binary, int value) const {
+    return implied_[2*binary+value];
+  }
+  /// Get number of implications.
+  int numImplications() const { return numImplications_; }
+  //@}
+
+  ///@name Global bound changes
+  //@{
+  /// Record that the global bounds of col are tightened.
+  void addTightened(int col);
+  /// Get columns tightened since the last clearTightened() call.
+  std::vector<int> const & tightened() const { return tightened_; }
+  /// Clear the list of tightened columns.
+  void clearTightened() { tightened_.clear(); }
+  /// Get number of global bound changes so far.
+  int numTightened() const { return numTightened_; }
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoImplications();
+  /// Disable copy constructor.
+  DcoImplications(DcoImplications const & other);
+  /// Disable copy assignment operator.
+  DcoImplications & operator=(DcoImplications const & rhs);
+};
+
+#endif
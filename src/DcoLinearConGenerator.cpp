@@ -2,9 +2,16 @@
 #include "DcoModel.hpp"
 #include "DcoMessage.hpp"
 #include "DcoLinearConstraint.hpp"
+#include "DcoImplications.hpp"
 
 #include <CglCutGenerator.hpp>
 #include <CglProbing.hpp>
+#include <OsiCuts.hpp>
+
+#include <cmath>
+
+/// Bound changes and implications smaller than this are ignored.
+static double const dcoProbingTol = 1e-6;
 
 /// Useful constructor.
 DcoLinearConGenerator::DcoLinearConGenerator(DcoModel * model,
@@ -15,6 +22,17 @@ DcoLinearConGenerator::DcoLinearConGenerator(DcoModel * model,
                         int frequency):
   DcoConGenerator(model, type, name, strategy, frequency) {
   generator_ = generator;
+  probing_ = dynamic_cast<CglProbing *>(generator_)!=NULL;
+  // get necessary objects for logging messages, generateCuts() does not log
+  // since it may run on a worker thread.
+  CoinMessageHandler * message_handler = model->dcoMessageHandler_;
+  // check whether we have a CGL generator
+  if (generator_==NULL) {
+    message_handler->message(9998, "Dco", "Linear cut generator has no"
+                             " Cgl generator.",
+                             'E', 0)
+      << CoinMessageEol;
+  }
 }
 
 /// Destructor.
@@ -22,80 +40,174 @@ DcoLinearConGenerator::~DcoLinearConGenerator() {
   delete generator_;
 }
 
-/// Generate constraints and add them to the pool.  return true if resolve is
-/// needed (because the state of the solver interface has been modified).
-bool DcoLinearConGenerator::generateConstraints(BcpsConstraintPool & conPool) {
-  // get necessary objects for logging messages
-  CoinMessageHandler * message_handler = model()->dcoMessageHandler_;
-  //CoinMessages * messages = model()->dcoMessages_;
-
-  // check whether we have a CGL generator
+/// Generate cuts for the current solution of solver.
+void DcoLinearConGenerator::generateCuts(OsiSolverInterface * solver,
+                                         OsiCuts & cuts) {
   if (generator_==NULL) {
-    message_handler->message(9998, "Dco", "Linear cut generator has no"
-                             " Cgl generator.",
-                             'E', 0)
-      << CoinMessageEol;
+    return;
   }
-
   // stop if cut strategy is auto and this generator did not perform well
   if (strategy() == DcoCutStrategyAuto) {
     int dis = model()->dcoPar()->entry(DcoParams::cutDisable);
     if (stats().numNoConsCalls()>dis) {
-      return false;
+      return;
     }
   }
-
-  OsiCuts new_cuts;
-
-  // we can not handle probing yet.
-  CglProbing * generator = dynamic_cast<CglProbing *>(generator_);
-  if (generator) {
-    message_handler->message(3000, "Dco",
-                             "Probing cut generator is not "
-                             "implemented yet. Skipping cut "
-                             "generation.",
-                             'W', 0)
-      << CoinMessageEol;
+  // need to refresh solver
+  // store generator type in a class member (DcoLinearCutType)
+  generator_->refreshSolver(solver);
+  if (probing_) {
+    // probing uses its root limits and its column cuts are globally valid
+    // only when it works with the global bounds.
+    CglTreeInfo info;
+    bool global = globalBounds(solver);
+    info.level = global ? 0 : 1;
+    info.inTree = !global;
+    generator_->generateCuts(*solver, cuts, info);
   }
   else {
-    // need to refresh solver
-    // store generator type in a class member (DcoLinearCutType)
-    generator_->refreshSolver(model()->solver());
-    generator_->generateCuts(*model()->solver(), new_cuts);
+    generator_->generateCuts(*solver, cuts);
   }
+}
 
+/// Record bound changes and implications found by probing.
+void DcoLinearConGenerator::recordCuts(OsiCuts const & cuts) {
+  if (!probing_) {
+    return;
+  }
+  // solver has the same bounds as the one probing worked on.
+  bool global = globalBounds(model()->solver());
+  // bound changes
+  int num_col_cuts = cuts.sizeColCuts();
+  for (int i=0; i<num_col_cuts; ++i) {
+    OsiColCut const & ccut = cuts.colCut(i);
+    CoinPackedVector const & lbs = ccut.lbs();
+    for (int k=0; k<lbs.getNumElements(); ++k) {
+      tightenBound(lbs.getIndices()[k], 'L', lbs.getElements()[k], global);
+    }
+    CoinPackedVector const & ubs = ccut.ubs();
+    for (int k=0; k<ubs.getNumElements(); ++k) {
+      tightenBound(ubs.getIndices()[k], 'U', ubs.getElements()[k], global);
+    }
+  }
+  // implications, row cuts found with node bounds are not globally valid.
+  if (!global) {
+    return;
+  }
+  int num_row_cuts = cuts.sizeRowCuts();
+  for (int i=0; i<num_row_cuts; ++i) {
+    OsiRowCut const & rcut = cuts.rowCut(i);
+    if (rcut.row().getNumElements()==2) {
+      addImplications(rcut.row().getIndices(), rcut.row().getElements(),
+                      rcut.lb(), rcut.ub());
+    }
+  }
+}
 
+bool DcoLinearConGenerator::globalBounds(OsiSolverInterface const * solver)
+  const {
+  DcoModel * model = DcoConGenerator::model();
+  std::vector<BcpsVariable*> & vars = model->getVariables();
+  double const * lb = solver->getColLower();
+  double const * ub = solver->getColUpper();
+  int num_cols = model->getNumCoreVariables();
+  for (int i=0; i<num_cols; ++i) {
+    if (lb[i]!=vars[i]->getLbHard() or ub[i]!=vars[i]->getUbHard()) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  // create disco constraints
-  int num_cuts = new_cuts.sizeRowCuts();
-  for (int i=0; i<num_cuts; ++i) {
-    OsiRowCut & rcut = new_cuts.rowCut(i);
-    int len = rcut.row().getNumElements();
-    int const * ind = rcut.row().getIndices();
-    double const * val = rcut.row().getElements();
-    double lb = rcut.lb();
-    double ub = rcut.ub();
-    if (len > 0) {
-      // create DcoConstraints from OsiCuts.
-      DcoConstraint * con = new DcoLinearConstraint(len, ind, val, lb, ub);
-      con->setConstraintType(type());
-      conPool.addConstraint(con);
+void DcoLinearConGenerator::tightenBound(int col, char sense, double bound,
+                                         bool global) {
+  DcoModel * model = DcoConGenerator::model();
+  OsiSolverInterface * solver = model->solver();
+  BcpsVariable * var = model->getVariables()[col];
+  if (var->getIntType()=='I') {
+    bound = (sense=='L') ? ceil(bound-dcoProbingTol) :
+      floor(bound+dcoProbingTol);
+  }
+  if (sense=='L') {
+    if (bound<=solver->getColLower()[col]+dcoProbingTol) {
+      return;
+    }
+    solver->setColLower(col, bound);
+    if (global) {
+      var->setLbHard(bound);
+    }
+  }
+  else {
+    if (bound>=solver->getColUpper()[col]-dcoProbingTol) {
+      return;
+    }
+    solver->setColUpper(col, bound);
+    if (global) {
+      var->setUbHard(bound);
     }
-    else if (len==0) {
-      // Empty cuts
-      std::stringstream msg;
-      msg << "Skipping empty cut generated by "
-          << name();
-      message_handler->message(3000, "Dco", msg.str().c_str(), 'W', 0)
-        << CoinMessageEol;
+  }
+  if (global) {
+    model->implications()->addTightened(col);
+  }
+}
+
+void DcoLinearConGenerator::addImplications(int const * ind,
+                                            double const * val,
+                                            double lb, double ub) {
+  DcoModel * model = DcoConGenerator::model();
+  std::vector<BcpsVariable*> & vars = model->getVariables();
+  DcoImplications * table = model->implications();
+  double infinity = model->solver()->getInfinity();
+  if (ind[0]==ind[1]) {
+    return;
+  }
+  // try both columns as the binary
+  for (int k=0; k<2; ++k) {
+    int b = ind[k];
+    int j = ind[1-k];
+    double a = val[k];
+    double c = val[1-k];
+    if (vars[b]->getIntType()!='I' or vars[b]->getLbHard()!=0.0 or
+        vars[b]->getUbHard()!=1.0 or fabs(c)<dcoProbingTol) {
+      continue;
     }
-    else {
-      std::stringstream msg;
-      msg << "Negative cut length given by "
-          << name();
-      message_handler->message(9998, "Dco", msg.str().c_str(), 'E', 0)
-        << CoinMessageEol;
+    double lbj = vars[j]->getLbHard();
+    double ubj = vars[j]->getUbHard();
+    bool integer = vars[j]->getIntType()=='I';
+    for (int v=0; v<2; ++v) {
+      // x_b = v gives lb - a v <= c x_j <= ub - a v
+      double lower = -infinity;
+      double upper = infinity;
+      if (ub<infinity) {
+        double r = (ub-a*v)/c;
+        if (c>0.0) {
+          upper = integer ? floor(r+dcoProbingTol) : r;
+        }
+        else {
+          lower = integer ? ceil(r-dcoProbingTol) : r;
+        }
+      }
+      if (lb>-infinity) {
+        double r = (lb-a*v)/c;
+        if (c>0.0) {
+          lower = integer ? ceil(r-dcoProbingTol) : r;
+        }
+        else {
+          upper = integer ? floor(r+dcoProbingTol) : r;
+        }
+      }
+      if (lower>ubj+dcoProbingTol or upper<lbj-dcoProbingTol or
+          lower>upper+dcoProbingTol) {
+        // x_b = v is infeasible, fix x_b to 1-v.
+        tightenBound(b, v ? 'U' : 'L', v ? 0.0 : 1.0, true);
+        break;
+      }
+      if (lower>lbj+dcoProbingTol) {
+        table->add(b, v, j, 'L', lower);
+      }
+      if (upper<ubj-dcoProbingTol) {
+        table->add(b, v, j, 'U', upper);
+      }
     }
   }
-  return false;
 }
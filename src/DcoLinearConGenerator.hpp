@@ -4,15 +4,35 @@
 #include "DcoConGenerator.hpp"
 
 class CglCutGenerator;
+class OsiSolverInterface;
 
 /*!
    DcoLinearConGenerator implements constraint generator interface for linear
    cut generating procedures.
+
+   Probing is called with a CglTreeInfo telling whether the solver has the
+   global bounds (root) or node bounds. Column cuts of probing tighten the
+   bounds in the solver. When they are found with the global bounds they
+   tighten the global bounds of the variables too and are recorded in the
+   model's implication table. Row cuts of probing with a binary and one other
+   column found with the global bounds are stored as implications. An
+   implication that makes the other column infeasible fixes the binary.
 */
 
 class DcoLinearConGenerator: virtual public DcoConGenerator {
   /// The CglCutGenerator object.
   CglCutGenerator * generator_;
+  /// Whether generator_ is probing.
+  bool probing_;
+  /// Returns true if solver has the global bounds of the variables.
+  bool globalBounds(OsiSolverInterface const * solver) const;
+  /// Tighten bound of col in the model's solver. sense is 'L' for lower and
+  /// 'U' for upper bound. If global is true the variable bound is tightened
+  /// and the change is recorded in the implication table.
+  void tightenBound(int col, char sense, double bound, bool global);
+  /// Store implications of the two column row cut lb <= val^T x <= ub.
+  void addImplications(int const * ind, double const * val, double lb,
+                       double ub);
 public:
   ///@name Constructors and Destructor
   //@{
@@ -29,9 +49,10 @@ public:
 
   ///@name Constraint generator functions
   //@{
-  /// Generate constraints and add them to the pool.  return true if resolve is
-  /// needed (because the state of the solver interface has been modified).
-  virtual bool generateConstraints(BcpsConstraintPool & conPool);
+  /// Generate cuts for the current solution of solver.
+  virtual void generateCuts(OsiSolverInterface * solver, OsiCuts & cuts);
+  /// Record bound changes and implications found by probing.
+  virtual void recordCuts(OsiCuts const & cuts);
   //@}
 
   // Get cut generator.
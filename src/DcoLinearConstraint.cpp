@@ -89,9 +89,33 @@ OsiRowCut * DcoLinearConstraint::createOsiRowCut(DcoModel * model) const {
 
 double DcoLinearConstraint::infeasibility(BcpsModel * m,
                                           int & preferredWay) const {
-  std::cerr << "Not implemented!" << std::endl;
-  throw std::exception();
-  return 0.0;
+  DcoModel * model = dynamic_cast<DcoModel*>(m);
+  preferredWay = 0;
+  // get solution stored in solver
+  double const * sol = model->solver()->getColSolution();
+  double infeas = infeasibility(sol);
+  // get primal tolerance of the solver
+  double primal_tol;
+  model->solver()->getDblParam(OsiPrimalTolerance, primal_tol);
+  if (infeas<=primal_tol) {
+    infeas = 0.0;
+  }
+  return infeas;
+}
+
+double DcoLinearConstraint::infeasibility(double const * sol) const {
+  double activity = 0.0;
+  for (int i=0; i<size_; ++i) {
+    activity += values_[i]*sol[indices_[i]];
+  }
+  double infeas = 0.0;
+  if (activity<getLbHard()) {
+    infeas = getLbHard() - activity;
+  }
+  else if (activity>getUbHard()) {
+    infeas = activity - getUbHard();
+  }
+  return infeas;
 }
 
 
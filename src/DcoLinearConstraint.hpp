@@ -34,7 +34,13 @@ public:
   int const * getIndices() const;
   double const * getValues() const;
   virtual OsiRowCut * createOsiRowCut(DcoModel * model) const;
+  /// Return infeasibility of this based on the solution stored in the
+  /// solver. Violations up to the primal tolerance of the solver are ignored.
   virtual double infeasibility(BcpsModel * m, int & preferredWay) const;
+  /// Return infeasibility of this at the given point, sol is a full column
+  /// solution. It is the violation of the row activity bounds, no tolerance
+  /// is applied.
+  double infeasibility(double const * sol) const;
 
   ///@name Encode and Decode functions
   //@{
@@ -76,9 +76,15 @@ int main(int argc, char *argv[]) {
 
   // Search for best solution
   broker.search(&model);
+  // solutions the heuristic thread found after the last node
+  model.collectHeuristicSolutions();
   model.reportFeasibility();
-  // Report the best solution found and its ojective value
-  broker.printBestSolution();
+  // Report the best solution found and its ojective value, it is written to
+  // Dco_solutionFile instead if it is set and the file can be written.
+  std::string solution_file = model.dcoPar()->entry(DcoParams::solutionFile);
+  if (solution_file.empty() or !model.writeSolution(solution_file.c_str())) {
+    broker.printBestSolution();
+  }
 
   delete solver;
   return 0;
@@ -0,0 +1,267 @@
+#include "DcoMappedFile.hpp"
+#include "Dco.hpp"
+
+#include <CoinFileIO.hpp>
+#include <CoinError.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+
+#if defined(DISCO_MMAP)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+DcoMappedFile::DcoMappedFile(): data_(NULL), size_(0), mapped_(false),
+                                fd_(-1) {
+}
+
+DcoMappedFile::~DcoMappedFile() {
+  close();
+}
+
+std::string DcoMappedFile::compression(std::string const & path) {
+  char const * suffixes[] = { ".gz", ".zst" };
+  for (int i=0; i<2; ++i) {
+    std::string suffix(suffixes[i]);
+    if (path.size()>suffix.size() and
+        !path.compare(path.size()-suffix.size(), suffix.size(), suffix)) {
+      return suffix;
+    }
+  }
+  return std::string();
+}
+
+bool DcoMappedFile::open(char const * path) {
+  close();
+  std::string suffix = compression(path);
+  if (suffix==".gz") {
+    return inflate(path);
+  }
+  else if (!suffix.empty()) {
+    return decompress(path);
+  }
+  name_ = path;
+#if defined(DISCO_MMAP)
+  int fd = ::open(path, O_RDONLY);
+  if (fd<0) {
+    return false;
+  }
+  bool ok = map(fd);
+  // mapping stays valid after the descriptor is closed.
+  ::close(fd);
+  return ok;
+#else
+  FILE * file = fopen(path, "rb");
+  if (file==NULL) {
+    return false;
+  }
+  char chunk[1<<16];
+  size_t num;
+  while ((num=fread(chunk, 1, sizeof(chunk), file))>0) {
+    buffer_.insert(buffer_.end(), chunk, chunk+num);
+  }
+  bool ok = !ferror(file);
+  fclose(file);
+  if (!ok) {
+    buffer_.clear();
+    return false;
+  }
+  size_ = buffer_.size();
+  data_ = size_ ? &buffer_[0] : NULL;
+  return true;
+#endif
+}
+
+bool DcoMappedFile::inflate(char const * path) {
+  if (!CoinFileInput::haveGzipSupport()) {
+    error_ = "CoinUtils is built without zlib";
+    return false;
+  }
+  // CoinFileInput does not tell a missing file from a broken one.
+  FILE * file = fopen(path, "rb");
+  if (file==NULL) {
+    return false;
+  }
+  fclose(file);
+  CoinFileInput * input = NULL;
+  try {
+    input = CoinFileInput::create(path);
+  }
+  catch (CoinError & e) {
+    error_ = e.message();
+    return false;
+  }
+  // decompressed size is not known in advance, contents grow chunk by chunk.
+  char chunk[1<<16];
+  int num;
+  while ((num=input->read(chunk, sizeof(chunk)))>0) {
+    buffer_.insert(buffer_.end(), chunk, chunk+num);
+  }
+  delete input;
+  if (num<0) {
+    error_ = "gzip data is corrupt";
+    std::vector<char>().swap(buffer_);
+    return false;
+  }
+  // readers using CoinFileInput, like CoinMpsIO, inflate it on their own.
+  name_ = path;
+  size_ = buffer_.size();
+  data_ = size_ ? &buffer_[0] : NULL;
+  return true;
+}
+
+#if defined(DISCO_MMAP)
+/// Returns the path of the first executable named program in PATH, empty
+/// string if there is none.
+static std::string dcoFindProgram(char const * program) {
+  char const * path = getenv("PATH");
+  std::string dirs(path ? path : "/usr/bin:/bin");
+  size_t start = 0;
+  while (start<=dirs.size()) {
+    size_t end = dirs.find(':', start);
+    if (end==std::string::npos) {
+      end = dirs.size();
+    }
+    // empty entry means the current directory
+    std::string dir = dirs.substr(start, end-start);
+    std::string file = (dir.empty() ? std::string(".") : dir) + "/" + program;
+    if (access(file.c_str(), X_OK)==0) {
+      return file;
+    }
+    start = end+1;
+  }
+  return std::string();
+}
+
+bool DcoMappedFile::map(int fd) {
+  struct stat info;
+  if (fstat(fd, &info) or !S_ISREG(info.st_mode)) {
+    return false;
+  }
+  size_ = info.st_size;
+  if (size_==0) {
+    return true;
+  }
+  void * addr = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (addr==MAP_FAILED) {
+    size_ = 0;
+    return false;
+  }
+  // contents are scanned front to back once.
+  madvise(addr, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<char const *>(addr);
+  mapped_ = true;
+  return true;
+}
+
+bool DcoMappedFile::decompress(char const * path) {
+  // zstd is run as it is found now, not looked up again by exec.
+  std::string program = dcoFindProgram("zstd");
+  if (program.empty()) {
+    error_ = "zstd is not found in PATH";
+    return false;
+  }
+  // in-memory file for the decompressed contents
+#if defined(MFD_CLOEXEC)
+  fd_ = memfd_create("disco-input", MFD_CLOEXEC);
+#endif
+  if (fd_<0) {
+    char const * dir = getenv("TMPDIR");
+    std::string temp_name = std::string(dir ? dir : "/tmp") +
+      "/disco-input-XXXXXX";
+    std::vector<char> name(temp_name.begin(), temp_name.end());
+    name.push_back('\0');
+    fd_ = mkstemp(&name[0]);
+    if (fd_<0) {
+      error_ = "can not create a temporary file";
+      return false;
+    }
+    tempName_ = &name[0];
+  }
+  pid_t pid = fork();
+  if (pid<0) {
+    close();
+    error_ = "can not start zstd";
+    return false;
+  }
+  if (pid==0) {
+    // decompressor writes to the in-memory file
+    if (dup2(fd_, STDOUT_FILENO)<0) {
+      _exit(127);
+    }
+    execl(program.c_str(), "zstd", "-dcq", "--", path, (char *)NULL);
+    _exit(127);
+  }
+  int status;
+  while (waitpid(pid, &status, 0)<0) {
+    // retry if a signal interrupts the wait, give up on other errors.
+    if (errno!=EINTR) {
+      close();
+      error_ = "can not wait for zstd";
+      return false;
+    }
+  }
+  if (!WIFEXITED(status) or WEXITSTATUS(status)!=0) {
+    close();
+    // child exits with 127 when it can not run zstd
+    if (WIFEXITED(status) and WEXITSTATUS(status)==127) {
+      error_ = "can not run " + program;
+    }
+    else {
+      error_ = "zstd failed, the file may be corrupt";
+    }
+    return false;
+  }
+  if (tempName_.empty()) {
+    // reopening /proc/self/fd/N gives its own file offset.
+    char fd_name[64];
+    sprintf(fd_name, "/proc/self/fd/%d", fd_);
+    name_ = fd_name;
+  }
+  else {
+    name_ = tempName_;
+  }
+  if (!map(fd_)) {
+    close();
+    return false;
+  }
+  return true;
+}
+#else
+bool DcoMappedFile::map(int fd) {
+  return false;
+}
+
+bool DcoMappedFile::decompress(char const * path) {
+  error_ = "zstd files are not supported without mmap";
+  return false;
+}
+#endif
+
+void DcoMappedFile::close() {
+#if defined(DISCO_MMAP)
+  if (mapped_ and data_) {
+    munmap(const_cast<char *>(data_), size_);
+  }
+  if (fd_>=0) {
+    ::close(fd_);
+  }
+  if (!tempName_.empty()) {
+    unlink(tempName_.c_str());
+  }
+#endif
+  std::vector<char>().swap(buffer_);
+  data_ = NULL;
+  size_ = 0;
+  mapped_ = false;
+  fd_ = -1;
+  name_.clear();
+  tempName_.clear();
+  error_.clear();
+}
@@ -0,0 +1,89 @@
+#ifndef DcoMappedFile_hpp_
+#define DcoMappedFile_hpp_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*!
+  DcoMappedFile gives read only access to the contents of a file as a
+  contiguous block of memory. The file is mapped to memory where mmap is
+  available (see DISCO_MMAP in Dco.hpp), it is read into a buffer
+  otherwise. Contents are not null terminated.
+
+  Files ending with .gz are inflated in process by CoinFileInput (zlib),
+  contents grow in a buffer and no temporary file is created. name() of a
+  gzip file is the file itself, readers that read through CoinFileInput,
+  like CoinMpsIO, inflate it on their own.
+
+  Files ending with .zst are decompressed by the zstd program found in
+  PATH, it writes to an in-memory file (memfd on Linux, a temporary file
+  in TMPDIR or /tmp elsewhere) that is then mapped. open() waits for zstd
+  to finish. Readers that take file names can open the decompressed
+  contents by name(), so the temporary file is kept until close() removes
+  it. zstd files are not supported without DISCO_MMAP. When decompression
+  fails error() tells why, a missing zstd or zlib included.
+*/
+
+class DcoMappedFile {
+  /// Contents of the file, NULL for empty or closed files.
+  char const * data_;
+  /// Size of the file in bytes.
+  size_t size_;
+  /// True if data_ is mapped, false if it points to buffer_.
+  bool mapped_;
+  /// Contents when mmap is not available.
+  std::vector<char> buffer_;
+  /// Descriptor of the decompressed contents, -1 for plain files.
+  int fd_;
+  /// Name that opens the contents.
+  std::string name_;
+  /// Temporary file to remove at close(), empty if none.
+  std::string tempName_;
+  /// Why the last open() could not decompress the file.
+  std::string error_;
+  /// Map the file open as fd.
+  bool map(int fd);
+  /// Inflate gzip file at path into buffer_.
+  bool inflate(char const * path);
+  /// Decompress zstd file at path to a new in-memory file, sets fd_, name_
+  /// and tempName_.
+  bool decompress(char const * path);
+public:
+  ///@name Constructors and Destructor
+  //@{
+  /// Default constructor.
+  DcoMappedFile();
+  /// Destructor, closes the file.
+  ~DcoMappedFile();
+  //@}
+
+  /// Map the file at path, decompressing it first if it is compressed.
+  /// Returns false if the file can not be opened, read or decompressed.
+  bool open(char const * path);
+  /// Release the contents.
+  void close();
+  /// Get the first byte of the contents.
+  char const * begin() const { return data_; }
+  /// Get the end of the contents.
+  char const * end() const { return data_+size_; }
+  /// Get size of the contents in bytes.
+  size_t size() const { return size_; }
+  /// Get a name that opens the (decompressed) contents while this is open.
+  std::string const & name() const { return name_; }
+  /// Get why the last open() could not decompress the file, empty if it
+  /// did not fail or the file could not be opened at all.
+  std::string const & error() const { return error_; }
+
+  /// Returns the compression suffix of path, .gz or .zst, empty string if
+  /// path is not compressed.
+  static std::string compression(std::string const & path);
+
+private:
+  /// Disable copy constructor.
+  DcoMappedFile(DcoMappedFile const & other);
+  /// Disable copy assignment operator.
+  DcoMappedFile & operator=(DcoMappedFile const & rhs);
+};
+
+#endif
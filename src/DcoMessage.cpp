@@ -78,6 +78,7 @@ typedef struct {
 // 6300-6399 Constraint generation warnings
 // 6400-6499 Relaxation solver warnings
 // 6500-6599 Heuristics warnings
+// 6600-6649 General warnings
 // 9200-9299 DcoTreeNode error messages
 // 9900-9999 general error messages
 // 9300-9399 Constraint generation errors
@@ -103,7 +104,7 @@ typedef struct {
 static Dco_message us_english[]=
 {
     {DISCO_CUTOFF_INC, 43, 1, "Objective coefficients are multiples of %g"},
-    {DISCO_CUT_STATS_FINAL, 53, 1, "Called %s cut generator %d times, generated %d cuts, used %d, CPU time %.4f seconds, current strategy %d"},
+    {DISCO_CUT_STATS_FINAL, 53, 1, "Called %s cut generator %d times, generated %d cuts, used %d, CPU time %.4f seconds, bound improvement %g, current strategy %d"},
     {DISCO_CUT_STATS_NODE, 55, 1, "Node %d, called %s cut generator %d times, generated %d cuts, used %d, CPU time %.4f seconds, current strategy %d"},
     {DISCO_CUT_GENERATED, 56, DISCO_DLOG_CUT, "[%d] Cut generator %s generated %d cuts."},
     {DISCO_GAP_NO, 57, 1, "Relative optimality gap is infinity because no solution was found"},
@@ -118,9 +119,13 @@ static Dco_message us_english[]=
     {DISCO_READ_NOINTS, 20, 1, "Problem does not have integer variables"},
     {DISCO_READ_NOCONES, 21, 1, "Problem does not have conic constraints."},
     {DISCO_READ_MPSERROR, 9001, 1, "Reading conic mps file failed with code %d." },
-    {DISCO_READ_MPSCBFFILEONLY,9002, 1, "Input should be in CBLIB's cbf or Mosek's conic mps format with extension cbf or mps."},
+    {DISCO_READ_MPSCBFFILEONLY,9002, 1, "Input should be in CBLIB's cbf or Mosek's conic mps format with extension cbf or mps, optionally followed by gz or zst."},
     {DISCO_READ_CONEERROR, 9003, 1, "Invalid cone type."},
     {DISCO_READ_ROTATEDCONESIZE, 9004, 1, "Rotated cones should have at least 3 members."},
+    {DISCO_READ_OPENERROR, 9007, 1, "Can not open or decompress file %s."},
+    {DISCO_READ_DECOMPRESSERROR, 9010, 1, "Can not decompress file %s, %s."},
+    {DISCO_READ_SNAPSHOTERROR, 9008, 1, "%s is not a valid model snapshot of version %d."},
+    {DISCO_LOAD_INVALID, 9009, 1, "Problem data is not valid, %s."},
     {DISCO_READ_CONESTATS1, 101, 3, "Problem has %d cones."},
     {DISCO_READ_CONESTATS2, 102, 3, "Cone %d has %d entries (type %d)"},
     {DISCO_PROBLEM_INFO, 103, 1, "Problem info.\n"
@@ -131,6 +136,15 @@ static Dco_message us_english[]=
      "  Number of nonzero in coefficient matrix: %d\n"
      "  Number of conic constraints: %d\n"
      "  Number of integer variables: %d"},
+    // mip start
+    {DISCO_MIPSTART_READ, 104, 1, "MIP start has values for %d of %d columns"},
+    {DISCO_MIPSTART_OPENERROR, 9005, 1, "Can not open MIP start file %s."},
+    {DISCO_MIPSTART_LINEERROR, 9006, 1, "MIP start file %s, line %d is not valid."},
+    {DISCO_MIPSTART_ACCEPTED, 508, 1, "MIP start is feasible, quality is %g"},
+    {DISCO_MIPSTART_REJECTED, 6501, 1, "MIP start is not feasible, column infeas %g, row infeas %g, cone infeas %g"},
+    {DISCO_MIPSTART_FAILED, 6502, 1, "MIP start is rejected, continuous problem is not solved to optimality"},
+    {DISCO_MIPSTART_BADINDEX, 6503, 1, "MIP start is ignored, column %d is out of range, problem has %d columns"},
+    {DISCO_MIPSTART_DUPINDEX, 6504, 1, "MIP start is ignored, column %d is given more than once"},
     // tree node
     {DISCO_NODE_BRANCHONINT, 9201, 1, "[%d] Branched on integer variable. Variable index %d."},
     {DISCO_NODE_UNEXPECTEDSTATUS,9202,1, "[%d] Unexpected node status %d"},
@@ -163,6 +177,8 @@ static Dco_message us_english[]=
     {DISCO_INVALID_HEUR_FREQUENCY, 9501, 1, "%d is not a valid heuristic frequency, changed it to %d."},
     {DISCO_HEUR_SOL_FOUND, 504, DISCO_DLOG_HEURISTIC, "[%d] %s heuristic found solution, quality %f."},
     {DISCO_HEUR_NOSOL_FOUND, 505, DISCO_DLOG_HEURISTIC, "[%d] %s heuristic is called and no solution is found."},
+    {DISCO_HEUR_ASYNC_STATS, 506, 1, "Heuristic thread processed %d node snapshots, dropped %d while busy"},
+    {DISCO_HEUR_POLISHED, 507, DISCO_DLOG_HEURISTIC, "[%d] Polished solution, quality %g changed to %g, cone infeasibility %g."},
     // branch strategies
     {DISCO_PSEUDO_REPORT, 551, DISCO_DLOG_BRANCH, "[%d] Pseudocost score of variable %d is %f."},
     {DISCO_PSEUDO_DUP, 552, DISCO_DLOG_BRANCH, "[%d] Updating down pseudocost of %d from %f to %f, frac value %f."},
@@ -183,6 +199,21 @@ static Dco_message us_english[]=
     {DISCO_SOL_FOUND, 604, DISCO_DLOG_PROCESS, "[%d] Solution found, quality %f."},
     {DISCO_SOL_INT_FEAS_REPORT, 605, 1, "Integrality maximum violation %f."},
     {DISCO_SOL_CONE_FEAS_REPORT, 606, 1, "Conic constraints maximum violation %f."},
+    {DISCO_CONE_EXTENDED, 607, 1, "Extended formulation: %d cones replaced by %d rotated cones, added %d columns and %d rows"},
+    {DISCO_CONE_BTN, 608, 1, "Polyhedral approximation of %d cones with accuracy %g, added %d columns and %d rows"},
+    {DISCO_SNAPSHOT_WRITTEN, 609, 1, "Model snapshot written to %s"},
+    {DISCO_SNAPSHOT_WRITEERROR, 6601, 1, "Can not write model snapshot to %s"},
+    {DISCO_CBF_WRITTEN, 610, 1, "Model written to %s in CBF format"},
+    {DISCO_CBF_WRITEERROR, 6602, 1, "Can not write model to %s in CBF format"},
+    {DISCO_OBJ_CONSTANT, 611, 1, "Objective constant %g is not included in the reported values, best solution value is %g"},
+    {DISCO_SOLUTION_WRITTEN, 612, 1, "Best solution written to %s"},
+    {DISCO_SOLUTION_WRITEERROR, 6603, 1, "Can not write solution to %s"},
+    {DISCO_INCUMBENT_WRITEERROR, 6604, 1, "Can not write incumbents to %s"},
+    {DISCO_PRESOLVE_DONE, 613, 1, "Presolve: %d passes, removed %d columns, %d rows and %d cones, tightened %d bounds and %d coefficients"},
+    {DISCO_PRESOLVE_INFEASIBLE, 6605, 1, "Presolve found the problem infeasible, original problem is solved"},
+    {DISCO_PROPAGATION_STATS, 614, 1, "Propagation: %d calls, %d nodes pruned, %d bounds tightened"},
+    {DISCO_RCFIX_STATS, 615, 1, "Reduced cost fixing: tightened %d global bounds at the root and %d bounds at the nodes"},
+    {DISCO_PRESOLVE_REDUCEDWRITE, 6606, 1, "Problem is presolved, %s has the reduced problem and its columns"},
     // welcome message
     {DISCO_WELCOME, 1, 0,
      "\nThis program contains DisCO, a library for solving mixed integer second order\n"
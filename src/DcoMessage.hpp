@@ -36,9 +36,22 @@ enum DISCO_Message {
     DISCO_READ_MPSCBFFILEONLY,
     DISCO_READ_CONEERROR,
     DISCO_READ_ROTATEDCONESIZE,
+    DISCO_READ_OPENERROR,
+    DISCO_READ_DECOMPRESSERROR,
+    DISCO_READ_SNAPSHOTERROR,
+    DISCO_LOAD_INVALID,
     DISCO_READ_CONESTATS1,
     DISCO_READ_CONESTATS2,
     DISCO_PROBLEM_INFO,
+    // mip start
+    DISCO_MIPSTART_READ,
+    DISCO_MIPSTART_OPENERROR,
+    DISCO_MIPSTART_LINEERROR,
+    DISCO_MIPSTART_ACCEPTED,
+    DISCO_MIPSTART_REJECTED,
+    DISCO_MIPSTART_FAILED,
+    DISCO_MIPSTART_BADINDEX,
+    DISCO_MIPSTART_DUPINDEX,
     // tree node
     DISCO_NODE_BRANCHONINT,
     DISCO_NODE_UNEXPECTEDSTATUS,
@@ -66,6 +79,8 @@ enum DISCO_Message {
     DISCO_INVALID_HEUR_FREQUENCY,
     DISCO_HEUR_SOL_FOUND,
     DISCO_HEUR_NOSOL_FOUND,
+    DISCO_HEUR_ASYNC_STATS,
+    DISCO_HEUR_POLISHED,
     // branch strategies
     DISCO_PSEUDO_REPORT,
     DISCO_PSEUDO_DUP,
@@ -83,6 +98,21 @@ enum DISCO_Message {
     DISCO_SOL_INT_FEAS_REPORT,
     DISCO_SOL_CONE_FEAS_REPORT,
     DISCO_SOL_FOUND,
+    DISCO_CONE_EXTENDED,
+    DISCO_CONE_BTN,
+    DISCO_SNAPSHOT_WRITTEN,
+    DISCO_SNAPSHOT_WRITEERROR,
+    DISCO_CBF_WRITTEN,
+    DISCO_CBF_WRITEERROR,
+    DISCO_OBJ_CONSTANT,
+    DISCO_SOLUTION_WRITTEN,
+    DISCO_SOLUTION_WRITEERROR,
+    DISCO_INCUMBENT_WRITEERROR,
+    DISCO_PRESOLVE_DONE,
+    DISCO_PRESOLVE_INFEASIBLE,
+    DISCO_PROPAGATION_STATS,
+    DISCO_RCFIX_STATS,
+    DISCO_PRESOLVE_REDUCEDWRITE,
     // welcome message
     DISCO_WELCOME,
     // out of memory
@@ -1,5 +1,7 @@
 // CoinUtils
 #include <CoinMpsIO.hpp>
+#include <CoinTime.hpp>
+#include <CoinHelperFunctions.hpp>
 
 // Disco headers
 #include "DcoModel.hpp"
@@ -15,11 +17,20 @@
 #include "DcoConGenerator.hpp"
 #include "DcoLinearConGenerator.hpp"
 #include "DcoConicConGenerator.hpp"
+#include "DcoConicOaGenerator.hpp"
+#include "DcoConicMirGenerator.hpp"
 #include "DcoSolution.hpp"
 #include "DcoPresolve.hpp"
 #include "DcoHeuristic.hpp"
 #include "DcoHeurRounding.hpp"
+#include "DcoHeurLocalSearch.hpp"
+#include "DcoHeurExecutor.hpp"
 #include "DcoCbfIO.hpp"
+#include "DcoMappedFile.hpp"
+#include "DcoImplications.hpp"
+#include "DcoPropagator.hpp"
+
+#include <AlpsKnowledgeBrokerSerial.h>
 
 // MILP cuts
 #include <CglCutGenerator.hpp>
@@ -41,12 +52,14 @@
 
 // STL headers
 #include <string>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <numeric>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
 
 // ordering of conNames should match the ordering of DcoConstraintType enum
 // type.
@@ -88,6 +101,7 @@ DcoModel::DcoModel() {
   numConicRows_ = 0;
   objSense_ = 0.0;
   objCoef_ = NULL;
+  objConstant_ = 0.0;
   numIntegerCols_ = 0;
   integerCols_ = NULL;
   isInteger_ = NULL;
@@ -95,20 +109,44 @@ DcoModel::DcoModel() {
   coneStart_ = NULL;
   coneMembers_ = NULL;
   coneType_ = NULL;
+  coneOsiType_ = NULL;
+  coneSize_ = NULL;
+  coneMemberPtr_ = NULL;
 
   dcoPar_ = new DcoParams();
   numRelaxedCols_ = 0;
   relaxedCols_ = NULL;
   numRelaxedRows_ = 0;
   relaxedRows_ = NULL;
+  relaxedRowInf_ = NULL;
+  relaxedRowInfValid_ = false;
   dcoMessageHandler_ = new CoinMessageHandler();
   dcoMessages_ = new DcoMessage();
   // set branch strategy
   branchStrategy_ = NULL;
   rampUpBranchStrategy_ = NULL;
   // cut and heuristics objects will be set in setupSelf.
+  heurExecutor_ = NULL;
+  localSearch_ = NULL;
+  mipStartSize_ = 0;
+  mipStartInd_ = NULL;
+  mipStartVal_ = NULL;
 
   initOAcuts_ = 0;
+  initOAcutRows_ = NULL;
+  initOAcutLB_ = NULL;
+  initOAcutUB_ = NULL;
+  preprocessed_ = false;
+  implications_ = NULL;
+  presolve_ = NULL;
+  propagator_ = NULL;
+  branchImp_ = 0.0;
+  branchTime_ = 0.0;
+  numBranchSamples_ = 0;
+  numRcFixedGlobal_ = 0;
+  numRcFixedNode_ = 0;
+  bestObjValue_ = COIN_DBL_MAX;
+  incumbentStream_ = NULL;
 
   dcoMessageHandler_->setPrefix(0);
   dcoMessageHandler_->message(DISCO_WELCOME, *dcoMessages_)
@@ -164,6 +202,18 @@ DcoModel::~DcoModel() {
     delete[] coneType_;
     coneType_=NULL;
   }
+  if (coneOsiType_) {
+    delete[] coneOsiType_;
+    coneOsiType_=NULL;
+  }
+  if (coneSize_) {
+    delete[] coneSize_;
+    coneSize_=NULL;
+  }
+  if (coneMemberPtr_) {
+    delete[] coneMemberPtr_;
+    coneMemberPtr_=NULL;
+  }
   if (branchStrategy_) {
     delete branchStrategy_;
     branchStrategy_=NULL;
@@ -192,17 +242,66 @@ DcoModel::~DcoModel() {
     delete[] relaxedRows_;
     relaxedRows_=NULL;
   }
+  if (relaxedRowInf_) {
+    delete[] relaxedRowInf_;
+    relaxedRowInf_=NULL;
+  }
+  if (mipStartInd_) {
+    delete[] mipStartInd_;
+    mipStartInd_=NULL;
+  }
+  if (mipStartVal_) {
+    delete[] mipStartVal_;
+    mipStartVal_=NULL;
+  }
   std::map<DcoConstraintType, DcoConGenerator*>::iterator it;
   for (it=conGenerators_.begin();
        it!=conGenerators_.end(); ++it) {
     delete it->second;
   }
   conGenerators_.clear();
+  if (implications_) {
+    delete implications_;
+    implications_ = NULL;
+  }
+  if (presolve_) {
+    delete presolve_;
+    presolve_ = NULL;
+  }
+  if (propagator_) {
+    delete propagator_;
+    propagator_ = NULL;
+  }
+  if (initOAcutRows_) {
+    delete initOAcutRows_;
+    initOAcutRows_ = NULL;
+  }
+  if (initOAcutLB_) {
+    delete[] initOAcutLB_;
+    initOAcutLB_ = NULL;
+  }
+  if (initOAcutUB_) {
+    delete[] initOAcutUB_;
+    initOAcutUB_ = NULL;
+  }
+  // executor should stop before heuristics are deleted
+  if (heurExecutor_) {
+    delete heurExecutor_;
+    heurExecutor_ = NULL;
+  }
   for (std::vector<DcoHeuristic*>::iterator it=heuristics_.begin();
        it!=heuristics_.end(); ++it) {
     delete *it;
   }
   heuristics_.clear();
+  if (localSearch_) {
+    delete localSearch_;
+    localSearch_ = NULL;
+  }
+  if (incumbentStream_) {
+    delete incumbentStream_;
+    incumbentStream_ = NULL;
+  }
 }
 
 #if defined(__OA__)
@@ -222,6 +321,9 @@ void DcoModel::setSolver(OsiConicSolverInterface * solver) {
 void DcoModel::readInstance(char const * dataFile) {
   // get input file name
   std::string input_file(dataFile);
+  // compressed files are decompressed by the readers, drop the suffix.
+  std::string compression = DcoMappedFile::compression(input_file);
+  input_file.erase(input_file.size()-compression.size());
   std::string base_name = input_file.substr(0, input_file.rfind('.'));
   std::string extension = input_file.substr(input_file.rfind('.')+1);
   if (!extension.compare("mps")) {
@@ -231,11 +333,17 @@ void DcoModel::readInstance(char const * dataFile) {
     problemName_ = base_name;
     readInstanceCbf(dataFile);
   }
+  else if (!extension.compare("snap")) {
+    readInstanceSnapshot(dataFile);
+  }
   else {
     dcoMessageHandler_->message(DISCO_READ_MPSCBFFILEONLY,
                                 *dcoMessages_) << CoinMessageEol;
   }
+  logProblemInfo();
+}
 
+void DcoModel::logProblemInfo() {
   // == log cone information messages
   if (numConicRows_) {
     dcoMessageHandler_->message(DISCO_READ_CONESTATS1,
@@ -256,7 +364,7 @@ void DcoModel::readInstance(char const * dataFile) {
   }
 
   // log problem information
-  std::string sense = (dcoPar_->entry(DcoParams::objSense)==1.0) ? std::string("min") : std::string("min");
+  std::string sense = (dcoPar_->entry(DcoParams::objSense)==1.0) ? std::string("min") : std::string("max");
   dcoMessageHandler_->message(DISCO_PROBLEM_INFO,
                               *dcoMessages_)
     << problemName_
@@ -269,46 +377,164 @@ void DcoModel::readInstance(char const * dataFile) {
     << CoinMessageEol;
 }
 
+void DcoModel::loadProblem(int numCols, int numRows,
+                           CoinBigIndex const * rowStart,
+                           int const * colIndex, double const * value,
+                           double const * colLB, double const * colUB,
+                           double const * objCoef, double const * rowLB,
+                           double const * rowUB, int const * isInteger,
+                           int numCones, int const * coneStart,
+                           int const * coneMembers, int const * coneType,
+                           double objSense, double objConstant) {
+  // problems without linear rows may come without row starts.
+  CoinBigIndex const empty_start = 0;
+  if (numRows==0) {
+    rowStart = &empty_start;
+  }
+  // check data, model should be empty.
+  char const * error = NULL;
+  if (matrix_) {
+    error = "model already has a problem";
+  }
+  else if (numCols<0 or numRows<0 or numCones<0) {
+    error = "negative size";
+  }
+  else if (rowStart[0]!=0 or (numCones and coneStart[0]!=0)) {
+    error = "first row or cone start is not 0";
+  }
+  for (int i=0; i<numRows and error==NULL; ++i) {
+    if (rowStart[i+1]<rowStart[i]) {
+      error = "row starts are not increasing";
+    }
+    for (CoinBigIndex j=rowStart[i]; j<rowStart[i+1] and error==NULL; ++j) {
+      if (colIndex[j]<0 or colIndex[j]>=numCols) {
+        error = "column index out of range";
+      }
+    }
+  }
+  for (int i=0; i<numCones and error==NULL; ++i) {
+    if (coneType[i]!=1 and coneType[i]!=2) {
+      error = "unknown cone type";
+    }
+    else if (coneStart[i+1]-coneStart[i]<coneType[i]+1) {
+      error = "cone has too few members";
+    }
+    for (int j=coneStart[i]; j<coneStart[i+1] and error==NULL; ++j) {
+      if (coneMembers[j]<0 or coneMembers[j]>=numCols) {
+        error = "cone member out of range";
+      }
+    }
+  }
+  if (error) {
+    dcoMessageHandler_->message(DISCO_LOAD_INVALID, *dcoMessages_)
+      << error << CoinMessageEol;
+    throw std::exception();
+  }
+  numCols_ = numCols;
+  numLinearRows_ = numRows;
+  numConicRows_ = numCones;
+  numRows_ = numLinearRows_ + numConicRows_;
+  // columns
+  colLB_ = new double[numCols_];
+  colUB_ = new double[numCols_];
+  objCoef_ = new double[numCols_];
+  std::copy(colLB, colLB+numCols_, colLB_);
+  std::copy(colUB, colUB+numCols_, colUB_);
+  std::copy(objCoef, objCoef+numCols_, objCoef_);
+  objSense_ = objSense;
+  objConstant_ = objConstant;
+  dcoPar_->setEntry(DcoParams::objSense, objSense_);
+  // integrality
+  isInteger_ = new int[numCols_]();
+  numIntegerCols_ = 0;
+  for (int i=0; isInteger and i<numCols_; ++i) {
+    if (isInteger[i]) {
+      isInteger_[i] = 1;
+      numIntegerCols_++;
+    }
+  }
+  integerCols_ = new int[numIntegerCols_];
+  for (int i=0, k=0; i<numCols_; ++i) {
+    if (isInteger_[i]) {
+      integerCols_[k++] = i;
+    }
+  }
+  // rows, conic row bounds follow linear rows.
+  rowLB_ = new double[numRows_];
+  rowUB_ = new double[numRows_];
+  std::copy(rowLB, rowLB+numLinearRows_, rowLB_);
+  std::copy(rowUB, rowUB+numLinearRows_, rowUB_);
+  std::fill_n(rowLB_+numLinearRows_, numConicRows_, 0.0);
+  std::fill_n(rowUB_+numLinearRows_, numConicRows_, COIN_DBL_MAX);
+  std::vector<int> length(numLinearRows_);
+  for (int i=0; i<numLinearRows_; ++i) {
+    length[i] = rowStart[i+1] - rowStart[i];
+  }
+  matrix_ = new CoinPackedMatrix(false, numCols_, numLinearRows_,
+                                 rowStart[numLinearRows_], value, colIndex,
+                                 rowStart, numLinearRows_ ? &length[0] : NULL);
+  // cones
+  coneStart_ = new int[numConicRows_+1];
+  coneType_ = new int[numConicRows_];
+  coneStart_[0] = 0;
+  if (numConicRows_) {
+    std::copy(coneStart, coneStart+numConicRows_+1, coneStart_);
+  }
+  std::copy(coneType, coneType+numConicRows_, coneType_);
+  coneMembers_ = new int[coneStart_[numConicRows_]];
+  std::copy(coneMembers, coneMembers+coneStart_[numConicRows_],
+            coneMembers_);
+  preprocessed_ = false;
+  logProblemInfo();
+}
+
+AlpsExitStatus DcoModel::solve() {
+  // broker reads parameters from the command line, there is none.
+  char program[] = "disco";
+  char * argv[] = { program, NULL };
+  AlpsKnowledgeBrokerSerial broker(1, argv, *this);
+  broker.search(this);
+  // solutions the heuristic thread found after the last node
+  collectHeuristicSolutions();
+  bestSolution_.clear();
+  bestObjValue_ = COIN_DBL_MAX;
+  if (broker.hasKnowledge(AlpsKnowledgeTypeSolution)) {
+    DcoSolution * best = dynamic_cast<DcoSolution*>
+      (broker.getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+    postsolve(best, bestSolution_);
+    bestObjValue_ = objSense_*broker.getIncumbentValue() + objConstant_;
+  }
+  std::string solution_file = dcoPar_->entry(DcoParams::solutionFile);
+  if (!solution_file.empty()) {
+    writeSolution(solution_file.c_str());
+  }
+  AlpsExitStatus status = broker.getSolStatus();
+  // broker is gone after this point.
+  broker_ = NULL;
+  return status;
+}
+
 // this should go into OsiConicSolverInterface or CoinUtils?
 void DcoModel::readInstanceCbf(char const * dataFile) {
   // mps file reader
   DcoCbfIO * reader = new DcoCbfIO();
+  reader->setNumThreads(dcoPar_->entry(DcoParams::readNumThreads));
   reader->readCbf(dataFile);
   // set objective sense
   objSense_ = reader->objSense();
+  objConstant_ = reader->objConstant();
   // set dcoPar_
   dcoPar_->setEntry(DcoParams::objSense, objSense_);
 
-  reader->getProblem(colLB_, colUB_, rowLB_, rowUB_, matrix_,
-                     numConicRows_, coneStart_, coneMembers_, coneType_);
+  // arrays are handed over by the reader, conic row bounds are included.
+  reader->assignProblem(colLB_, colUB_, rowLB_, rowUB_, matrix_, objCoef_,
+                        numIntegerCols_, integerCols_, numConicRows_,
+                        coneStart_, coneMembers_, coneType_);
   numCols_ = matrix_->getNumCols();
   numLinearRows_ = matrix_->getNumRows();
   numRows_ = numLinearRows_ + numConicRows_;
 
-  // add conic row bounds to rowLB and rowUB
-  double * tempRowLB = new double[numRows_];
-  std::copy(rowLB_, rowLB_+numLinearRows_, tempRowLB);
-  std::fill_n(tempRowLB+numLinearRows_, numConicRows_, 0.0);
-  delete[] rowLB_;
-  rowLB_ = tempRowLB;
-  tempRowLB = NULL;
-  double * tempRowUB = new double[numRows_];
-  std::copy(rowUB_, rowUB_+numLinearRows_, tempRowUB);
-  std::fill_n(tempRowUB+numLinearRows_, numConicRows_, reader->getInfinity());
-  delete[] rowUB_;
-  rowUB_ = tempRowUB;
-  tempRowUB = NULL;
-
-  objCoef_ = new double [numCols_]();
-
-  std::copy(reader->objCoef(), reader->objCoef()+reader->getNumCols(),
-            objCoef_);
-
   // get integrality info
-  numIntegerCols_ = reader->getNumInteger();
-  integerCols_ = new int[numIntegerCols_];
-  std::copy(reader->integerCols(), reader->integerCols()+numIntegerCols_,
-            integerCols_);
   isInteger_ = new int[numCols_]();
   for (int i=0; i<numIntegerCols_; ++i) {
     isInteger_[integerCols_[i]] = 1;
@@ -323,7 +549,27 @@ void DcoModel::readInstanceMps(char const * dataFile) {
   // set reader log level
   //reader->messageHandler()->setLogLevel(dcoPar_->entry(DcoParams::logLevel));
   reader->messageHandler()->setLogLevel(0);
-  reader->readMps(dataFile, "");
+  // CoinMpsIO opens files by name, and opens it again for the conic
+  // section. It inflates gzip files itself, zstd files are decompressed to
+  // memory under a name that opens the decompressed contents.
+  DcoMappedFile decompressed;
+  std::string file_name(dataFile);
+  if (DcoMappedFile::compression(file_name)==".zst") {
+    if (!decompressed.open(dataFile)) {
+      if (decompressed.error().empty()) {
+        dcoMessageHandler_->message(DISCO_READ_OPENERROR, *dcoMessages_)
+          << dataFile << CoinMessageEol;
+      }
+      else {
+        dcoMessageHandler_->message(DISCO_READ_DECOMPRESSERROR,
+                                    *dcoMessages_)
+          << dataFile << decompressed.error() << CoinMessageEol;
+      }
+      throw std::exception();
+    }
+    file_name = decompressed.name();
+  }
+  reader->readMps(file_name.c_str(), "");
   numCols_ = reader->getNumCols();
 
   // allocate variable bounds
@@ -341,6 +587,8 @@ void DcoModel::readInstanceMps(char const * dataFile) {
   objCoef_ = new double [numCols_];
   double const * reader_obj = reader->getObjCoefficients();
   std::copy(reader_obj, reader_obj+numCols_, objCoef_);
+  // offset is the right hand side of the objective row.
+  objConstant_ = -reader->objectiveOffset();
 
   // set integer columns
   // get variable integrality constraints
@@ -419,6 +667,563 @@ void DcoModel::readInstanceMps(char const * dataFile) {
   delete reader;
 }
 
+/// First bytes of model snapshot files.
+static char const dcoSnapshotMagic[8] = {'D','C','O','S','N','A','P','\0'};
+/// Version of the snapshot format, increase when the layout changes.
+static int const dcoSnapshotVersion = 2;
+/// Written after the version, reads differently on machines with a
+/// different byte order.
+static int const dcoSnapshotByteOrder = 0x01020304;
+
+/// Pad the snapshot to a multiple of 8 bytes so that arrays are aligned in
+/// the mapped file.
+static void dcoSnapshotPad(std::ostream & out) {
+  static char const zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  int rem = static_cast<int>(out.tellp()) % 8;
+  if (rem) {
+    out.write(zeros, 8-rem);
+  }
+}
+
+/// Write an array of size entries, size first.
+template <class T>
+static void dcoSnapshotWrite(std::ostream & out, T const * data, int size) {
+  out.write(reinterpret_cast<char const *>(&size), sizeof(int));
+  dcoSnapshotPad(out);
+  if (size) {
+    out.write(reinterpret_cast<char const *>(data), size*sizeof(T));
+  }
+  dcoSnapshotPad(out);
+}
+
+/// Write a row ordered matrix without gaps, row starts have numRows+1
+/// entries.
+static void dcoSnapshotWriteMatrix(std::ostream & out,
+                                   CoinPackedMatrix const & matrix) {
+  int num_rows = matrix.getMajorDim();
+  CoinBigIndex const * starts = matrix.getVectorStarts();
+  int const * lengths = matrix.getVectorLengths();
+  std::vector<int> row_start(num_rows+1, 0);
+  for (int i=0; i<num_rows; ++i) {
+    row_start[i+1] = row_start[i] + lengths[i];
+  }
+  std::vector<int> ind(row_start[num_rows]);
+  std::vector<double> val(row_start[num_rows]);
+  for (int i=0; i<num_rows; ++i) {
+    std::copy(matrix.getIndices()+starts[i],
+              matrix.getIndices()+starts[i]+lengths[i],
+              ind.begin()+row_start[i]);
+    std::copy(matrix.getElements()+starts[i],
+              matrix.getElements()+starts[i]+lengths[i],
+              val.begin()+row_start[i]);
+  }
+  dcoSnapshotWrite(out, &row_start[0], num_rows+1);
+  dcoSnapshotWrite(out, ind.empty() ? NULL : &ind[0], ind.size());
+  dcoSnapshotWrite(out, val.empty() ? NULL : &val[0], val.size());
+}
+
+/*!
+  Reads a snapshot from memory. Reads fail, without touching the output,
+  once the data is short or an array size does not match.
+*/
+class DcoSnapshotReader {
+  char const * begin_;
+  char const * pos_;
+  char const * end_;
+  bool ok_;
+  void align() {
+    size_t offset = ((pos_-begin_+7)/8)*8;
+    if (offset>static_cast<size_t>(end_-begin_)) {
+      ok_ = false;
+      offset = end_-begin_;
+    }
+    pos_ = begin_ + offset;
+  }
+public:
+  DcoSnapshotReader(char const * begin, char const * end):
+    begin_(begin), pos_(begin), end_(end), ok_(true) {}
+  bool ok() const { return ok_; }
+  bool atEnd() const { return pos_==end_; }
+  bool readBytes(void * out, size_t size) {
+    if (!ok_ or static_cast<size_t>(end_-pos_)<size) {
+      ok_ = false;
+      return false;
+    }
+    memcpy(out, pos_, size);
+    pos_ += size;
+    return true;
+  }
+  /// Read an array into a new array. size should be the expected size or
+  /// -1 to accept any size.
+  template <class T>
+  T * readArray(int & size) {
+    int stored;
+    if (!readBytes(&stored, sizeof(int)) or stored<0 or
+        (size>=0 and stored!=size)) {
+      ok_ = false;
+      return NULL;
+    }
+    align();
+    if (!ok_ or static_cast<size_t>(end_-pos_)<stored*sizeof(T)) {
+      ok_ = false;
+      return NULL;
+    }
+    T * data = new T[stored];
+    if (!readBytes(data, stored*sizeof(T))) {
+      delete[] data;
+      return NULL;
+    }
+    align();
+    size = stored;
+    return data;
+  }
+  /// Read a row ordered matrix with numRows rows and numCols columns.
+  CoinPackedMatrix * readMatrix(int numRows, int numCols) {
+    int num_starts = numRows+1;
+    int * row_start = readArray<int>(num_starts);
+    int num_elem = -1;
+    int * ind = readArray<int>(num_elem);
+    int num_val = num_elem;
+    double * val = readArray<double>(num_val);
+    if (!ok_ or row_start[0]!=0 or row_start[numRows]!=num_elem) {
+      ok_ = false;
+      delete[] row_start;
+      delete[] ind;
+      delete[] val;
+      return NULL;
+    }
+    CoinBigIndex * start = new CoinBigIndex[numRows+1];
+    int * length = new int[numRows];
+    for (int i=0; i<numRows; ++i) {
+      start[i] = row_start[i];
+      length[i] = row_start[i+1] - row_start[i];
+    }
+    start[numRows] = num_elem;
+    delete[] row_start;
+    CoinPackedMatrix * matrix = new CoinPackedMatrix();
+    // matrix takes ownership of the arrays
+    matrix->assignMatrix(false, numCols, numRows, num_elem, val, ind,
+                         start, length);
+    return matrix;
+  }
+};
+
+bool DcoModel::writeSnapshot(char const * file) const {
+  // reduced problem is written, postsolve stack is not.
+  if (presolve_) {
+    dcoMessageHandler_->message(DISCO_PRESOLVE_REDUCEDWRITE, *dcoMessages_)
+      << file << CoinMessageEol;
+  }
+  std::ofstream out(file, std::ios::out | std::ios::binary);
+  if (!out.is_open()) {
+    dcoMessageHandler_->message(DISCO_SNAPSHOT_WRITEERROR, *dcoMessages_)
+      << file << CoinMessageEol;
+    return false;
+  }
+  out.write(dcoSnapshotMagic, sizeof(dcoSnapshotMagic));
+  out.write(reinterpret_cast<char const *>(&dcoSnapshotVersion), sizeof(int));
+  out.write(reinterpret_cast<char const *>(&dcoSnapshotByteOrder),
+            sizeof(int));
+  dcoSnapshotWrite(out, problemName_.c_str(), problemName_.size());
+  int sizes[5] = {numCols_, numLinearRows_, numConicRows_, numIntegerCols_,
+                  initOAcuts_};
+  dcoSnapshotWrite(out, sizes, 5);
+  dcoSnapshotWrite(out, &objSense_, 1);
+  dcoSnapshotWrite(out, &objConstant_, 1);
+  dcoSnapshotWrite(out, colLB_, numCols_);
+  dcoSnapshotWrite(out, colUB_, numCols_);
+  dcoSnapshotWrite(out, objCoef_, numCols_);
+  dcoSnapshotWrite(out, isInteger_, numCols_);
+  dcoSnapshotWrite(out, integerCols_, numIntegerCols_);
+  dcoSnapshotWrite(out, rowLB_, numRows_);
+  dcoSnapshotWrite(out, rowUB_, numRows_);
+  dcoSnapshotWrite(out, coneStart_, numConicRows_ ? numConicRows_+1 : 0);
+  dcoSnapshotWrite(out, coneType_, numConicRows_);
+  dcoSnapshotWrite(out, coneMembers_,
+                   numConicRows_ ? coneStart_[numConicRows_] : 0);
+  if (matrix_->isColOrdered()) {
+    CoinPackedMatrix by_row;
+    by_row.reverseOrderedCopyOf(*matrix_);
+    dcoSnapshotWriteMatrix(out, by_row);
+  }
+  else {
+    dcoSnapshotWriteMatrix(out, *matrix_);
+  }
+  if (initOAcuts_) {
+    dcoSnapshotWriteMatrix(out, *initOAcutRows_);
+    dcoSnapshotWrite(out, initOAcutLB_, initOAcuts_);
+    dcoSnapshotWrite(out, initOAcutUB_, initOAcuts_);
+  }
+  out.close();
+  if (out.fail()) {
+    dcoMessageHandler_->message(DISCO_SNAPSHOT_WRITEERROR, *dcoMessages_)
+      << file << CoinMessageEol;
+    return false;
+  }
+  dcoMessageHandler_->message(DISCO_SNAPSHOT_WRITTEN, *dcoMessages_)
+    << file << CoinMessageEol;
+  return true;
+}
+
+void DcoModel::readInstanceSnapshot(char const * dataFile) {
+  DcoMappedFile file;
+  if (!file.open(dataFile)) {
+    if (file.error().empty()) {
+      dcoMessageHandler_->message(DISCO_READ_OPENERROR, *dcoMessages_)
+        << dataFile << CoinMessageEol;
+    }
+    else {
+      dcoMessageHandler_->message(DISCO_READ_DECOMPRESSERROR, *dcoMessages_)
+        << dataFile << file.error() << CoinMessageEol;
+    }
+    throw std::exception();
+  }
+  DcoSnapshotReader reader(file.begin(), file.end());
+  char magic[sizeof(dcoSnapshotMagic)];
+  int version = 0;
+  int byte_order = 0;
+  reader.readBytes(magic, sizeof(magic));
+  reader.readBytes(&version, sizeof(int));
+  reader.readBytes(&byte_order, sizeof(int));
+  if (!reader.ok() or memcmp(magic, dcoSnapshotMagic, sizeof(magic)) or
+      version!=dcoSnapshotVersion or byte_order!=dcoSnapshotByteOrder) {
+    dcoMessageHandler_->message(DISCO_READ_SNAPSHOTERROR, *dcoMessages_)
+      << dataFile << dcoSnapshotVersion << CoinMessageEol;
+    throw std::exception();
+  }
+  int name_size = -1;
+  char * name = reader.readArray<char>(name_size);
+  if (name) {
+    problemName_.assign(name, name_size);
+    delete[] name;
+  }
+  int num_sizes = 5;
+  int * sizes = reader.readArray<int>(num_sizes);
+  if (sizes) {
+    numCols_ = sizes[0];
+    numLinearRows_ = sizes[1];
+    numConicRows_ = sizes[2];
+    numIntegerCols_ = sizes[3];
+    initOAcuts_ = sizes[4];
+    numRows_ = numLinearRows_ + numConicRows_;
+    delete[] sizes;
+  }
+  int one = 1;
+  double * sense = reader.readArray<double>(one);
+  if (sense) {
+    objSense_ = sense[0];
+    delete[] sense;
+  }
+  double * constant = reader.readArray<double>(one);
+  if (constant) {
+    objConstant_ = constant[0];
+    delete[] constant;
+  }
+  int num_cols = numCols_;
+  int num_rows = numRows_;
+  int num_ints = numIntegerCols_;
+  int num_cone_starts = numConicRows_ ? numConicRows_+1 : 0;
+  int num_cones = numConicRows_;
+  colLB_ = reader.readArray<double>(num_cols);
+  colUB_ = reader.readArray<double>(num_cols);
+  objCoef_ = reader.readArray<double>(num_cols);
+  isInteger_ = reader.readArray<int>(num_cols);
+  integerCols_ = reader.readArray<int>(num_ints);
+  rowLB_ = reader.readArray<double>(num_rows);
+  rowUB_ = reader.readArray<double>(num_rows);
+  coneStart_ = reader.readArray<int>(num_cone_starts);
+  coneType_ = reader.readArray<int>(num_cones);
+  int num_members = (reader.ok() and numConicRows_) ?
+    coneStart_[numConicRows_] : 0;
+  coneMembers_ = reader.readArray<int>(num_members);
+  if (reader.ok()) {
+    matrix_ = reader.readMatrix(numLinearRows_, numCols_);
+  }
+  if (reader.ok() and initOAcuts_) {
+    int num_cuts = initOAcuts_;
+    initOAcutRows_ = reader.readMatrix(initOAcuts_, numCols_);
+    initOAcutLB_ = reader.readArray<double>(num_cuts);
+    initOAcutUB_ = reader.readArray<double>(num_cuts);
+  }
+  if (!reader.ok() or !reader.atEnd()) {
+    dcoMessageHandler_->message(DISCO_READ_SNAPSHOTERROR, *dcoMessages_)
+      << dataFile << dcoSnapshotVersion << CoinMessageEol;
+    throw std::exception();
+  }
+#if !defined(__OA__)
+  // cones are not relaxed, approximation cuts are not used.
+  initOAcuts_ = 0;
+#endif
+  // objective sense is the one the snapshot is written with.
+  dcoPar_->setEntry(DcoParams::objSense, objSense_);
+  preprocessed_ = true;
+}
+
+
+/// Bounds with absolute value at least this are infinite in CBF files.
+static double const dcoCbfInfinity = 1e30;
+
+/// Names of CBF domains, in the order of CONES.
+static char const * const dcoCbfDomainName[] = {"F", "L+", "L-", "L=",
+                                                "Q", "QR"};
+
+/// Split bounds lb <= a^T x <= ub of a row into CBF rows a^T x + b in dom.
+/// Returns number of rows, free rows are dropped.
+static int dcoCbfSplitRow(double lb, double ub, CONES * dom, double * b) {
+  bool has_lb = lb>-dcoCbfInfinity;
+  bool has_ub = ub<dcoCbfInfinity;
+  if (has_lb and has_ub and lb==ub) {
+    dom[0] = FIXPOINT_ZERO;
+    b[0] = -lb;
+    return 1;
+  }
+  int num = 0;
+  if (has_lb) {
+    dom[num] = POSITIVE_ORT;
+    b[num++] = -lb;
+  }
+  if (has_ub) {
+    dom[num] = NEGATIVE_ORT;
+    b[num++] = -ub;
+  }
+  return num;
+}
+
+/// Append num entries in domain type to a CBF domain list. Linear domains
+/// are merged with the last one, each cone is a domain of its own.
+static void dcoCbfAddDomain(std::vector<CONES> & dom, std::vector<int> & size,
+                            CONES type, int num) {
+  bool linear = type!=QUAD_CONE and type!=RQUAD_CONE;
+  if (linear and !dom.empty() and dom.back()==type) {
+    size.back() += num;
+  }
+  else {
+    dom.push_back(type);
+    size.push_back(num);
+  }
+}
+
+/// Write VAR or CON block.
+static void dcoCbfWriteDomains(std::ostream & out, char const * block,
+                               int total, std::vector<CONES> const & dom,
+                               std::vector<int> const & size) {
+  out << block << "\n" << total << " " << dom.size() << "\n";
+  for (unsigned int i=0; i<dom.size(); ++i) {
+    out << dcoCbfDomainName[dom[i]] << " " << size[i] << "\n";
+  }
+  out << "\n";
+}
+
+// CBF rows are written in the order linear rows, approximation cuts,
+// column bounds not implied by the column domains and cones that are not
+// column domains. Rows are enumerated once for the CON block, once for
+// ACOORD and once for BCOORD, entries are not stored.
+bool DcoModel::writeCbf(char const * file, bool cuts) const {
+  // reduced problem is written, postsolve stack is not.
+  if (presolve_) {
+    dcoMessageHandler_->message(DISCO_PRESOLVE_REDUCEDWRITE, *dcoMessages_)
+      << file << CoinMessageEol;
+  }
+  std::ofstream out(file);
+  if (!out.is_open()) {
+    dcoMessageHandler_->message(DISCO_CBF_WRITEERROR, *dcoMessages_)
+      << file << CoinMessageEol;
+    return false;
+  }
+  out.precision(17);
+  // row blocks, coefficient matrix and approximation cuts
+  CoinPackedMatrix by_row;
+  if (matrix_->isColOrdered()) {
+    by_row.reverseOrderedCopyOf(*matrix_);
+  }
+  CoinPackedMatrix const * blocks[2] = {
+    matrix_->isColOrdered() ? &by_row : matrix_, initOAcutRows_ };
+  double const * block_lb[2] = { rowLB_, initOAcutLB_ };
+  double const * block_ub[2] = { rowUB_, initOAcutUB_ };
+  int block_rows[2] = { numLinearRows_,
+                        (cuts and initOAcutRows_) ? initOAcuts_ : 0 };
+  // cones with consecutive members are column domains, col_cone[i] is the
+  // cone column i is in, -1 if it is not in a cone domain.
+  std::vector<int> col_cone(numCols_, -1);
+  std::vector<bool> cone_domain(numConicRows_, false);
+  for (int k=0; k<numConicRows_; ++k) {
+    int const * members = coneMembers_ + coneStart_[k];
+    int size = coneStart_[k+1] - coneStart_[k];
+    bool consecutive = true;
+    for (int j=0; j<size and consecutive; ++j) {
+      consecutive = members[j]==members[0]+j and col_cone[members[j]]==-1;
+    }
+    if (consecutive) {
+      cone_domain[k] = true;
+      std::fill_n(col_cone.begin()+members[0], size, k);
+    }
+  }
+  // column domains and the bounds left to write as rows
+  std::vector<CONES> var_dom;
+  std::vector<int> var_size;
+  std::vector<double> lb(colLB_, colLB_+numCols_);
+  std::vector<double> ub(colUB_, colUB_+numCols_);
+  for (int i=0; i<numCols_; ++i) {
+    int k = col_cone[i];
+    if (k>=0) {
+      int first = coneMembers_[coneStart_[k]];
+      if (i==first) {
+        dcoCbfAddDomain(var_dom, var_size,
+                        coneType_[k]==1 ? QUAD_CONE : RQUAD_CONE,
+                        coneStart_[k+1]-coneStart_[k]);
+      }
+      // leading members are nonnegative in the cone
+      if (i-first<coneType_[k] and lb[i]<=0.0) {
+        lb[i] = -COIN_DBL_MAX;
+      }
+    }
+    else if (lb[i]==0.0 and ub[i]==0.0) {
+      dcoCbfAddDomain(var_dom, var_size, FIXPOINT_ZERO, 1);
+      lb[i] = -COIN_DBL_MAX;
+      ub[i] = COIN_DBL_MAX;
+    }
+    else if (lb[i]==0.0) {
+      dcoCbfAddDomain(var_dom, var_size, POSITIVE_ORT, 1);
+      lb[i] = -COIN_DBL_MAX;
+    }
+    else if (ub[i]==0.0) {
+      dcoCbfAddDomain(var_dom, var_size, NEGATIVE_ORT, 1);
+      ub[i] = COIN_DBL_MAX;
+    }
+    else {
+      dcoCbfAddDomain(var_dom, var_size, FREE_RANGE, 1);
+    }
+  }
+  // row domains and sizes of ACOORD and BCOORD
+  std::vector<CONES> con_dom;
+  std::vector<int> con_size;
+  int num_rows = 0;
+  CoinBigIndex num_nz = 0;
+  int num_fixed = 0;
+  CONES dom[2];
+  double fixed[2];
+  for (int b=0; b<2; ++b) {
+    for (int i=0; i<block_rows[b]; ++i) {
+      int num = dcoCbfSplitRow(block_lb[b][i], block_ub[b][i], dom, fixed);
+      for (int k=0; k<num; ++k) {
+        dcoCbfAddDomain(con_dom, con_size, dom[k], 1);
+        num_fixed += fixed[k]!=0.0;
+      }
+      num_rows += num;
+      num_nz += num*blocks[b]->getVectorSize(i);
+    }
+  }
+  for (int i=0; i<numCols_; ++i) {
+    int num = dcoCbfSplitRow(lb[i], ub[i], dom, fixed);
+    for (int k=0; k<num; ++k) {
+      dcoCbfAddDomain(con_dom, con_size, dom[k], 1);
+      num_fixed += fixed[k]!=0.0;
+    }
+    num_rows += num;
+    num_nz += num;
+  }
+  for (int k=0; k<numConicRows_; ++k) {
+    if (!cone_domain[k]) {
+      int size = coneStart_[k+1] - coneStart_[k];
+      dcoCbfAddDomain(con_dom, con_size,
+                      coneType_[k]==1 ? QUAD_CONE : RQUAD_CONE, size);
+      num_rows += size;
+      num_nz += size;
+    }
+  }
+  // header, objective and domains
+  out << "# " << problemName_ << ", written by DisCO\n";
+  out << "VER\n1\n\n";
+  out << "OBJSENSE\n" << (objSense_<0.0 ? "MAX" : "MIN") << "\n\n";
+  dcoCbfWriteDomains(out, "VAR", numCols_, var_dom, var_size);
+  if (numIntegerCols_) {
+    out << "INT\n" << numIntegerCols_ << "\n";
+    for (int i=0; i<numIntegerCols_; ++i) {
+      out << integerCols_[i] << "\n";
+    }
+    out << "\n";
+  }
+  if (num_rows) {
+    dcoCbfWriteDomains(out, "CON", num_rows, con_dom, con_size);
+  }
+  int num_obj = numCols_ - std::count(objCoef_, objCoef_+numCols_, 0.0);
+  out << "OBJACOORD\n" << num_obj << "\n";
+  for (int i=0; i<numCols_; ++i) {
+    if (objCoef_[i]!=0.0) {
+      out << i << " " << objCoef_[i] << "\n";
+    }
+  }
+  out << "\n";
+  if (objConstant_!=0.0) {
+    out << "OBJBCOORD\n" << objConstant_ << "\n\n";
+  }
+  // coefficients
+  if (num_nz) {
+    out << "ACOORD\n" << num_nz << "\n";
+    int row = 0;
+    for (int b=0; b<2; ++b) {
+      CoinBigIndex const * starts = blocks[b] ? blocks[b]->getVectorStarts()
+        : NULL;
+      int const * lengths = blocks[b] ? blocks[b]->getVectorLengths() : NULL;
+      int const * indices = blocks[b] ? blocks[b]->getIndices() : NULL;
+      double const * values = blocks[b] ? blocks[b]->getElements() : NULL;
+      for (int i=0; i<block_rows[b]; ++i) {
+        int num = dcoCbfSplitRow(block_lb[b][i], block_ub[b][i], dom, fixed);
+        for (int k=0; k<num; ++k, ++row) {
+          for (CoinBigIndex j=starts[i]; j<starts[i]+lengths[i]; ++j) {
+            out << row << " " << indices[j] << " " << values[j] << "\n";
+          }
+        }
+      }
+    }
+    for (int i=0; i<numCols_; ++i) {
+      int num = dcoCbfSplitRow(lb[i], ub[i], dom, fixed);
+      for (int k=0; k<num; ++k, ++row) {
+        out << row << " " << i << " 1\n";
+      }
+    }
+    for (int k=0; k<numConicRows_; ++k) {
+      if (!cone_domain[k]) {
+        for (int j=coneStart_[k]; j<coneStart_[k+1]; ++j, ++row) {
+          out << row << " " << coneMembers_[j] << " 1\n";
+        }
+      }
+    }
+    out << "\n";
+  }
+  // constant terms
+  if (num_fixed) {
+    out << "BCOORD\n" << num_fixed << "\n";
+    int row = 0;
+    for (int b=0; b<2; ++b) {
+      for (int i=0; i<block_rows[b]; ++i) {
+        int num = dcoCbfSplitRow(block_lb[b][i], block_ub[b][i], dom, fixed);
+        for (int k=0; k<num; ++k, ++row) {
+          if (fixed[k]!=0.0) {
+            out << row << " " << fixed[k] << "\n";
+          }
+        }
+      }
+    }
+    for (int i=0; i<numCols_; ++i) {
+      int num = dcoCbfSplitRow(lb[i], ub[i], dom, fixed);
+      for (int k=0; k<num; ++k, ++row) {
+        if (fixed[k]!=0.0) {
+          out << row << " " << fixed[k] << "\n";
+        }
+      }
+    }
+  }
+  out.close();
+  if (out.fail()) {
+    dcoMessageHandler_->message(DISCO_CBF_WRITEERROR, *dcoMessages_)
+      << file << CoinMessageEol;
+    return false;
+  }
+  dcoMessageHandler_->message(DISCO_CBF_WRITTEN, *dcoMessages_)
+    << file << CoinMessageEol;
+  return true;
+}
 
 void DcoModel::readParameters(const int argnum,
                               const char * const * arglist) {
@@ -508,22 +1313,428 @@ void DcoModel::preprocess() {
   // // set message levels
   // setMessageLevel();
 
+  // write parameters used
+  //writeParameters(std::cout);
 
-  // // some bounds are improved if updated is true
+  // snapshots are written after preprocessing.
+  if (preprocessed_) {
+    return;
+  }
 
-  // // notes(aykut) this can only improve the bounds if the leading variable is
-  // // bounded.  most of the time it is not. Things can get better if we use some
-  // // other bound improvement first and it does improve the upper bound of
-  // // leading variables.
-  // //bool updated = DcoPresolve::improve_bounds(this);
+  // presolve works on the fields set by readInstance(), before cones are
+  // reformulated.
+  if (dcoPar_->entry(DcoParams::presolve)) {
+    presolve();
+  }
 
-  // write parameters used
-  //writeParameters(std::cout);
+  // reformulate cones, updates the fields set by readInstance().
+  int reformulation = dcoPar_->entry(DcoParams::coneReformulation);
+  if (numConicRows_ and reformulation==1) {
+    extendCones();
+  }
+  if (numConicRows_ and reformulation==2) {
+    // polyhedral approximation is added to the linear rows, no need for the
+    // approximation rounds.
+    approximateConesBtn();
+  }
+  else {
+    // approximation of cones will update numLinearRows_, numRows_, rowLB_,
+    // rowUB_, matrix_.
+    approximateCones();
+  }
+  preprocessed_ = true;
+
+  std::string snapshot_file = dcoPar_->entry(DcoParams::snapshotFile);
+  if (!snapshot_file.empty()) {
+    writeSnapshot(snapshot_file.c_str());
+  }
+  std::string cbf_file = dcoPar_->entry(DcoParams::cbfFile);
+  if (!cbf_file.empty()) {
+    writeCbf(cbf_file.c_str());
+  }
+}
+
+void DcoModel::presolve() {
+  presolve_ = new DcoPresolve(numCols_, numLinearRows_, matrix_, colLB_,
+                              colUB_, objCoef_, isInteger_, rowLB_, rowUB_,
+                              numConicRows_, coneStart_, coneMembers_,
+                              coneType_);
+  bool feasible =
+    presolve_->presolve(dcoPar_->entry(DcoParams::presolveNumPass),
+                        dcoPar_->entry(DcoParams::presolveTolerance),
+                        dcoPar_->entry(DcoParams::presolveKeepIntegers),
+                        dcoPar_->entry(DcoParams::presolveTransform));
+  if (!feasible) {
+    // search proves infeasibility on the original problem.
+    dcoMessageHandler_->message(DISCO_PRESOLVE_INFEASIBLE, *dcoMessages_)
+      << CoinMessageEol;
+    delete presolve_;
+    presolve_ = NULL;
+    return;
+  }
+  // replace fields
+  delete[] colLB_;
+  delete[] colUB_;
+  delete[] objCoef_;
+  delete[] isInteger_;
+  delete[] integerCols_;
+  delete[] rowLB_;
+  delete[] rowUB_;
+  delete matrix_;
+  delete[] coneStart_;
+  delete[] coneMembers_;
+  delete[] coneType_;
+  presolve_->getProblem(numCols_, numLinearRows_, colLB_, colUB_, objCoef_,
+                        isInteger_, numIntegerCols_, integerCols_, rowLB_,
+                        rowUB_, matrix_, numConicRows_, coneStart_,
+                        coneMembers_, coneType_);
+  numRows_ = numLinearRows_ + numConicRows_;
+  objConstant_ += presolve_->objOffset();
+  dcoMessageHandler_->message(DISCO_PRESOLVE_DONE, *dcoMessages_)
+    << presolve_->numPasses()
+    << presolve_->numRemovedCols()
+    << presolve_->numRemovedRows()
+    << presolve_->numRemovedCones()
+    << presolve_->numTightened()
+    << presolve_->numCoefChanged()
+    << CoinMessageEol;
+  // a MIP start set before is in terms of the original columns.
+  if (mipStartSize_) {
+    presolveMipStart();
+  }
+}
+
+void DcoModel::presolveMipStart() {
+  int size = 0;
+  for (int i=0; i<mipStartSize_; ++i) {
+    int col = presolve_->reducedIndex(mipStartInd_[i]);
+    if (col>=0) {
+      mipStartInd_[size] = col;
+      mipStartVal_[size] = mipStartVal_[i];
+      size++;
+    }
+  }
+  mipStartSize_ = size;
+}
+
+void DcoModel::extendCones() {
+  // count cones to reformulate and new columns, cones with a single term are
+  // kept as they are.
+  int num_extended = 0;
+  int num_new_cols = 0;
+  for (int i=0; i<numConicRows_; ++i) {
+    int num_terms = coneStart_[i+1] - coneStart_[i] - coneType_[i];
+    if (num_terms>1) {
+      num_extended++;
+      num_new_cols += num_terms;
+    }
+  }
+  if (num_extended==0) {
+    return;
+  }
+  int new_num_cols = numCols_ + num_new_cols;
+  int new_num_linear = numLinearRows_ + num_extended;
+  int new_num_cones = numConicRows_ - num_extended + num_new_cols;
+  // new columns are continuous, nonnegative and do not appear in objective.
+  double * col_lb = new double[new_num_cols];
+  double * col_ub = new double[new_num_cols];
+  double * obj = new double[new_num_cols];
+  int * is_integer = new int[new_num_cols];
+  std::copy(colLB_, colLB_+numCols_, col_lb);
+  std::copy(colUB_, colUB_+numCols_, col_ub);
+  std::copy(objCoef_, objCoef_+numCols_, obj);
+  std::copy(isInteger_, isInteger_+numCols_, is_integer);
+  std::fill_n(col_lb+numCols_, num_new_cols, 0.0);
+  std::fill_n(col_ub+numCols_, num_new_cols, COIN_DBL_MAX);
+  std::fill_n(obj+numCols_, num_new_cols, 0.0);
+  std::fill_n(is_integer+numCols_, num_new_cols, 0);
+  // linear rows go before conic rows in row bounds.
+  double * row_lb = new double[new_num_linear+new_num_cones];
+  double * row_ub = new double[new_num_linear+new_num_cones];
+  std::copy(rowLB_, rowLB_+numLinearRows_, row_lb);
+  std::copy(rowUB_, rowUB_+numLinearRows_, row_ub);
+  std::fill_n(row_lb+numLinearRows_, num_extended, -COIN_DBL_MAX);
+  std::fill_n(row_ub+numLinearRows_, num_extended, 0.0);
+  std::fill_n(row_lb+new_num_linear, new_num_cones, 0.0);
+  std::fill_n(row_ub+new_num_linear, new_num_cones, COIN_DBL_MAX);
+  // new cones
+  int * cone_start = new int[new_num_cones+1];
+  int * cone_type = new int[new_num_cones];
+  // kept cones keep their members, every new cone has 3 members.
+  int * cone_members = new int[coneStart_[numConicRows_] + 3*num_new_cols];
+  matrix_->setDimensions(numLinearRows_, new_num_cols);
+  std::vector<int> row_ind;
+  std::vector<double> row_val;
+  int next_col = numCols_;
+  int num_cones = 0;
+  cone_start[0] = 0;
+  for (int i=0; i<numConicRows_; ++i) {
+    int const * members = coneMembers_ + coneStart_[i];
+    int size = coneStart_[i+1] - coneStart_[i];
+    int num_terms = size - coneType_[i];
+    if (num_terms<2) {
+      // keep cone as it is
+      int start = cone_start[num_cones];
+      std::copy(members, members+size, cone_members+start);
+      cone_type[num_cones] = coneType_[i];
+      cone_start[++num_cones] = start + size;
+      continue;
+    }
+    // 2x_1t_j >= x_j^2 for every term x_j, t_j is column next_col.
+    row_ind.clear();
+    row_val.clear();
+    for (int j=coneType_[i]; j<size; ++j) {
+      int start = cone_start[num_cones];
+      cone_members[start] = members[0];
+      cone_members[start+1] = next_col;
+      cone_members[start+2] = members[j];
+      cone_type[num_cones] = 2;
+      cone_start[++num_cones] = start + 3;
+      row_ind.push_back(next_col++);
+      row_val.push_back(coneType_[i]==1 ? 2.0 : 1.0);
+    }
+    // sum of t_j is bounded by x_1/2 for Lorentz cones, x_2 for rotated.
+    row_ind.push_back(members[coneType_[i]-1]);
+    row_val.push_back(-1.0);
+    matrix_->appendRow(row_ind.size(), &row_ind[0], &row_val[0]);
+  }
+  // message
+  dcoMessageHandler_->message(DISCO_CONE_EXTENDED, *dcoMessages_)
+    << num_extended
+    << num_new_cols
+    << num_new_cols
+    << num_extended
+    << CoinMessageEol;
+  // replace fields
+  delete[] colLB_;
+  delete[] colUB_;
+  delete[] objCoef_;
+  delete[] isInteger_;
+  delete[] rowLB_;
+  delete[] rowUB_;
+  delete[] coneStart_;
+  delete[] coneType_;
+  delete[] coneMembers_;
+  colLB_ = col_lb;
+  colUB_ = col_ub;
+  objCoef_ = obj;
+  isInteger_ = is_integer;
+  rowLB_ = row_lb;
+  rowUB_ = row_ub;
+  coneStart_ = cone_start;
+  coneType_ = cone_type;
+  coneMembers_ = cone_members;
+  numCols_ = new_num_cols;
+  numLinearRows_ = new_num_linear;
+  numConicRows_ = new_num_cones;
+  numRows_ = numLinearRows_ + numConicRows_;
+}
 
-  // approximation of cones will update numLinearRows_, numRows_, rowLB_,
-  // rowUB_, matrix_.
-  approximateCones();
+/// Largest number of levels used to approximate a 2 dimensional cone.
+static int const dcoBtnMaxDepth = 20;
+
+/// Collects columns and rows of the Ben-Tal--Nemirovski approximation, used
+/// by DcoModel::approximateConesBtn(). Columns are numbered after the columns
+/// of the model.
+class DcoBtnBuilder {
+  /// Index of the next column.
+  int nextCol_;
+public:
+  ///@name New columns and rows, rows are in CSR form.
+  //@{
+  std::vector<double> colLB;
+  std::vector<int> rowStart;
+  std::vector<int> rowInd;
+  std::vector<double> rowVal;
+  std::vector<double> rowLB;
+  std::vector<double> rowUB;
+  //@}
+  DcoBtnBuilder(int numCols): nextCol_(numCols) { rowStart.push_back(0); }
+  /// Add a column with lower bound lb and no upper bound.
+  int addCol(double lb) {
+    colLB.push_back(lb);
+    return nextCol_++;
+  }
+  /// Add row lb <= val[0]x_ind[0] + val[1]x_ind[1] (+ val[2]x_ind[2]) <= ub.
+  void addRow(int size, int const * ind, double const * val, double lb,
+              double ub) {
+    rowInd.insert(rowInd.end(), ind, ind+size);
+    rowVal.insert(rowVal.end(), val, val+size);
+    rowLB.push_back(lb);
+    rowUB.push_back(ub);
+    rowStart.push_back(rowInd.size());
+  }
+  /// Add t >= |a|.
+  void addAbs(int t, int a) {
+    int ind[] = {t, a};
+    double plus[] = {1.0, 1.0};
+    double minus[] = {1.0, -1.0};
+    addRow(2, ind, plus, 0.0, COIN_DBL_MAX);
+    addRow(2, ind, minus, 0.0, COIN_DBL_MAX);
+  }
+  /// Add approximation of t >= ||(a,b)|| with depth levels.
+  void addNorm2(int t, int a, int b, int depth) {
+    double const pi = acos(-1.0);
+    int xi = addCol(0.0);
+    int eta = addCol(0.0);
+    addAbs(xi, a);
+    addAbs(eta, b);
+    for (int j=1; j<=depth; ++j) {
+      double angle = pi/pow(2.0, j+1);
+      double c = cos(angle);
+      double s = sin(angle);
+      int next_xi = addCol(0.0);
+      int next_eta = addCol(0.0);
+      // next_xi = c xi + s eta
+      int ind[] = {next_xi, xi, eta};
+      double val[] = {1.0, -c, -s};
+      addRow(3, ind, val, 0.0, 0.0);
+      // next_eta >= |c eta - s xi|
+      int ind2[] = {next_eta, xi, eta};
+      double plus[] = {1.0, s, -c};
+      double minus[] = {1.0, -s, c};
+      addRow(3, ind2, plus, 0.0, COIN_DBL_MAX);
+      addRow(3, ind2, minus, 0.0, COIN_DBL_MAX);
+      xi = next_xi;
+      eta = next_eta;
+    }
+    // t >= xi, eta <= tan(pi/2^(depth+1)) xi
+    int ind[] = {t, xi};
+    double val[] = {1.0, -1.0};
+    addRow(2, ind, val, 0.0, COIN_DBL_MAX);
+    int ind2[] = {xi, eta};
+    double val2[] = {tan(pi/pow(2.0, depth+1)), -1.0};
+    addRow(2, ind2, val2, 0.0, COIN_DBL_MAX);
+  }
+  /// Add approximation of lead >= ||terms||. Terms are paired in a balanced
+  /// tree of 2 dimensional cones.
+  void addCone(int lead, std::vector<int> terms, int depth) {
+    while (terms.size()>2) {
+      std::vector<int> next;
+      for (unsigned int i=0; i+1<terms.size(); i+=2) {
+        int y = addCol(0.0);
+        addNorm2(y, terms[i], terms[i+1], depth);
+        next.push_back(y);
+      }
+      if (terms.size()%2) {
+        next.push_back(terms.back());
+      }
+      terms.swap(next);
+    }
+    if (terms.size()==2) {
+      addNorm2(lead, terms[0], terms[1], depth);
+    }
+    else if (terms.size()==1) {
+      addAbs(lead, terms[0]);
+    }
+  }
+  /// Number of columns added.
+  int numCols() const { return colLB.size(); }
+  /// Number of rows added.
+  int numRows() const { return rowLB.size(); }
+};
 
+void DcoModel::approximateConesBtn() {
+  double const pi = acos(-1.0);
+  double const sqrt2 = sqrt(2.0);
+  double eps = dcoPar_->entry(DcoParams::approxFactor);
+  DcoBtnBuilder builder(numCols_);
+  for (int i=0; i<numConicRows_; ++i) {
+    int const * members = coneMembers_ + coneStart_[i];
+    int size = coneStart_[i+1] - coneStart_[i];
+    int lead;
+    std::vector<int> terms;
+    if (coneType_[i]==1) {
+      lead = members[0];
+      terms.assign(members+1, members+size);
+    }
+    else {
+      // 2x_1x_2 >= ||x_3n||^2 is u >= ||(v, x_3n)|| where
+      // u = (x_1+x_2)/sqrt(2) and v = (x_1-x_2)/sqrt(2).
+      lead = builder.addCol(0.0);
+      int v = builder.addCol(-COIN_DBL_MAX);
+      int ind_u[] = {lead, members[0], members[1]};
+      double val_u[] = {sqrt2, -1.0, -1.0};
+      builder.addRow(3, ind_u, val_u, 0.0, 0.0);
+      int ind_v[] = {v, members[0], members[1]};
+      double val_v[] = {sqrt2, -1.0, 1.0};
+      builder.addRow(3, ind_v, val_v, 0.0, 0.0);
+      terms.push_back(v);
+      terms.insert(terms.end(), members+2, members+size);
+    }
+    // errors of the 2 dimensional cones multiply along the tree, pick the
+    // smallest depth that keeps ||terms|| <= (1+eps) lead.
+    int tree_height = 0;
+    while ((1<<tree_height) < static_cast<int>(terms.size())) {
+      tree_height++;
+    }
+    int depth = 1;
+    while (depth<dcoBtnMaxDepth and
+           pow(1.0/cos(pi/pow(2.0, depth+1)), tree_height) > 1.0+eps) {
+      depth++;
+    }
+    builder.addCone(lead, terms, depth);
+  }
+  int num_new_cols = builder.numCols();
+  int num_new_rows = builder.numRows();
+  if (num_new_rows==0) {
+    return;
+  }
+  int new_num_cols = numCols_ + num_new_cols;
+  int new_num_linear = numLinearRows_ + num_new_rows;
+  // new columns are continuous and do not appear in objective.
+  double * col_lb = new double[new_num_cols];
+  double * col_ub = new double[new_num_cols];
+  double * obj = new double[new_num_cols];
+  int * is_integer = new int[new_num_cols];
+  std::copy(colLB_, colLB_+numCols_, col_lb);
+  std::copy(colUB_, colUB_+numCols_, col_ub);
+  std::copy(objCoef_, objCoef_+numCols_, obj);
+  std::copy(isInteger_, isInteger_+numCols_, is_integer);
+  std::copy(builder.colLB.begin(), builder.colLB.end(), col_lb+numCols_);
+  std::fill_n(col_ub+numCols_, num_new_cols, COIN_DBL_MAX);
+  std::fill_n(obj+numCols_, num_new_cols, 0.0);
+  std::fill_n(is_integer+numCols_, num_new_cols, 0);
+  // linear rows go before conic rows in row bounds, cones do not change.
+  double * row_lb = new double[new_num_linear+numConicRows_];
+  double * row_ub = new double[new_num_linear+numConicRows_];
+  std::copy(rowLB_, rowLB_+numLinearRows_, row_lb);
+  std::copy(rowUB_, rowUB_+numLinearRows_, row_ub);
+  std::copy(builder.rowLB.begin(), builder.rowLB.end(),
+            row_lb+numLinearRows_);
+  std::copy(builder.rowUB.begin(), builder.rowUB.end(),
+            row_ub+numLinearRows_);
+  std::copy(rowLB_+numLinearRows_, rowLB_+numRows_, row_lb+new_num_linear);
+  std::copy(rowUB_+numLinearRows_, rowUB_+numRows_, row_ub+new_num_linear);
+  matrix_->setDimensions(numLinearRows_, new_num_cols);
+  for (int i=0; i<num_new_rows; ++i) {
+    int start = builder.rowStart[i];
+    matrix_->appendRow(builder.rowStart[i+1]-start, &builder.rowInd[start],
+                       &builder.rowVal[start]);
+  }
+  // message
+  dcoMessageHandler_->message(DISCO_CONE_BTN, *dcoMessages_)
+    << numConicRows_
+    << eps
+    << num_new_cols
+    << num_new_rows
+    << CoinMessageEol;
+  // replace fields
+  delete[] colLB_;
+  delete[] colUB_;
+  delete[] objCoef_;
+  delete[] isInteger_;
+  delete[] rowLB_;
+  delete[] rowUB_;
+  colLB_ = col_lb;
+  colUB_ = col_ub;
+  objCoef_ = obj;
+  isInteger_ = is_integer;
+  rowLB_ = row_lb;
+  rowUB_ = row_ub;
+  numCols_ = new_num_cols;
+  numLinearRows_ = new_num_linear;
+  numRows_ = numLinearRows_ + numConicRows_;
 }
 
 void DcoModel::approximateCones() {
@@ -542,24 +1753,10 @@ void DcoModel::approximateCones() {
   // solve problem
   solver_->resolve();
   // get cone data in the required form
-  // todo(aykut) think about updating cut library for the input format
-  OsiLorentzConeType * coneTypes = new OsiLorentzConeType[numConicRows_];
-  int * coneSizes = new int[numConicRows_];
-  int const ** coneMembers = new int const *[numConicRows_];
-  for (int i=0; i<numConicRows_; ++i) {
-    if (coneType_[i]==1) {
-      coneTypes[i] = OSI_QUAD;
-    }
-    else if (coneType_[i]==2) {
-      coneTypes[i] = OSI_RQUAD;
-    }
-    else {
-      dcoMessageHandler_->message(DISCO_UNKNOWN_CONETYPE, *dcoMessages_)
-        << __FILE__ << __LINE__ << CoinMessageEol;
-    }
-    coneSizes[i] = coneStart_[i+1]-coneStart_[i];
-    coneMembers[i] = coneMembers_ + coneStart_[i];
-  }
+  setupConeData();
+  OsiLorentzConeType const * coneTypes = coneOsiType_;
+  int const * coneSizes = coneSize_;
+  int const * const * coneMembers = coneMemberPtr_;
   // used to decide on number of iterations in outer approximation
   int largest_cone_size = *std::max_element(coneSizes,
                                             coneSizes+numConicRows_);
@@ -626,9 +1823,6 @@ void DcoModel::approximateCones() {
   std::cout << "Linear relaxation objective value "
             << solver_->getObjValue() << std::endl;
   std::cout << "=================================" << std::endl;
-  delete[] coneTypes;
-  delete[] coneSizes;
-  delete[] coneMembers;
 
   double cutOaSlack = dcoPar_->entry(DcoParams::cutOaSlack1);
   // print cut activity
@@ -710,6 +1904,24 @@ void DcoModel::approximateCones() {
     }
   }
   initOAcuts_ = solver_->getNumRows() - numLinearRows_;
+  // keep the cuts, setupSelf() loads the problem to the solver again.
+  if (initOAcuts_) {
+    std::vector<int> cut_rows(initOAcuts_);
+    for (int i=0; i<initOAcuts_; ++i) {
+      cut_rows[i] = numLinearRows_+i;
+    }
+    initOAcutRows_ = new CoinPackedMatrix();
+    initOAcutRows_->submatrixOf(*solver_->getMatrixByRow(), initOAcuts_,
+                                &cut_rows[0]);
+    initOAcutLB_ = new double[initOAcuts_];
+    initOAcutUB_ = new double[initOAcuts_];
+    std::copy(solver_->getRowLower()+numLinearRows_,
+              solver_->getRowLower()+numLinearRows_+initOAcuts_,
+              initOAcutLB_);
+    std::copy(solver_->getRowUpper()+numLinearRows_,
+              solver_->getRowUpper()+numLinearRows_+initOAcuts_,
+              initOAcutUB_);
+  }
 
   // get updated data from solver
   // delete matrix_;
@@ -746,6 +1958,17 @@ bool DcoModel::setupSelf() {
             relaxedCols_);
   // set iteration count to 0
   numRelaxIterations_ = 0;
+  // cone data used by conic cut generators
+  setupConeData();
+  // implication table, filled by probing
+  implications_ = new DcoImplications(numCols_);
+  // node bound propagation over the core linear rows and cones
+  if (dcoPar_->entry(DcoParams::propagate)) {
+    propagator_ = new DcoPropagator(numCols_, numLinearRows_, matrix_, rowLB_,
+                                    rowUB_, isInteger_, numConicRows_,
+                                    coneStart_, coneMembers_, coneType_);
+    propagator_->setImplications(implications_);
+  }
 #ifdef __OA__
   solver_->reset();
   solver_->setHintParam(OsiDoInBranchAndCut, true, OsiHintDo, NULL);
@@ -762,6 +1985,11 @@ bool DcoModel::setupSelf() {
   solver_->setInteger(integerCols_, numIntegerCols_);
 
 #if defined(__OA__)
+  // approximation cuts follow the linear rows in the solver.
+  for (int i=0; i<initOAcuts_; ++i) {
+    solver_->addRow(initOAcutRows_->getVector(i), initOAcutLB_[i],
+                    initOAcutUB_[i]);
+  }
   // we relax conic constraints when OA is used.
   // set relaxed array for conic constraints
   numRelaxedRows_ = numConicRows_;
@@ -770,6 +1998,8 @@ bool DcoModel::setupSelf() {
   for (int i=0; i<numRelaxedRows_; ++i) {
     relaxedRows_[i] = numLinearRows_+i;
   }
+  relaxedRowInf_ = new double[numRelaxedRows_]();
+  relaxedRowInfValid_ = false;
 
   // set leading variable lower bounds to 0
   for (int i=0; i<numConicRows_; ++i) {
@@ -826,11 +2056,51 @@ bool DcoModel::setupSelf() {
   // set cutoff for solvers if user provides one.
   double cutoff = dcoPar_->entry(DcoParams::cutoff);
   if (cutoff!=ALPS_INC_MAX) {
+    // objective value of the columns removed by presolve is not in the
+    // values of the model.
+    if (presolve_) {
+      cutoff -= presolve_->objOffset();
+    }
     solver_->setDblParam(OsiDualObjectiveLimit, objSense_*cutoff);
   }
+
+  // process MIP start, only master has the start in parallel code.
+  if (broker_->getProcType()==AlpsProcessTypeMaster or
+      broker_->getProcType()==AlpsProcessTypeSerial) {
+    std::string start_file = dcoPar_->entry(DcoParams::mipStartFile);
+    if (mipStartSize_==0 and !start_file.empty()) {
+      readMipStart(start_file.c_str());
+    }
+    if (mipStartSize_) {
+      processMipStart();
+    }
+  }
   return true;
 }
 
+void DcoModel::setupConeData() {
+  if (coneSize_) {
+    return;
+  }
+  coneOsiType_ = new OsiLorentzConeType[numConicRows_];
+  coneSize_ = new int[numConicRows_];
+  coneMemberPtr_ = new int const *[numConicRows_];
+  for (int i=0; i<numConicRows_; ++i) {
+    if (coneType_[i]==1) {
+      coneOsiType_[i] = OSI_QUAD;
+    }
+    else if (coneType_[i]==2) {
+      coneOsiType_[i] = OSI_RQUAD;
+    }
+    else {
+      dcoMessageHandler_->message(DISCO_UNKNOWN_CONETYPE, *dcoMessages_)
+        << coneType_[i] << CoinMessageEol;
+    }
+    coneSize_[i] = coneStart_[i+1]-coneStart_[i];
+    coneMemberPtr_[i] = coneMembers_ + coneStart_[i];
+  }
+}
+
 // set message level
 void DcoModel::setMessageLevel() {
   // get Alps log level
@@ -908,6 +2178,8 @@ void DcoModel::addConstraintGenerators() {
     (dcoPar_->entry(DcoParams::cutIpmIntStrategy));
   DcoCutStrategy oaStrategy = static_cast<DcoCutStrategy>
     (dcoPar_->entry(DcoParams::cutOaStrategy));
+  DcoCutStrategy conicMirStrategy = static_cast<DcoCutStrategy>
+    (dcoPar_->entry(DcoParams::conicCutMirStrategy));
 
   // get cut frequencies from parameters
   int cliqueFreq = dcoPar_->entry(DcoParams::cutCliqueFreq);
@@ -921,6 +2193,7 @@ void DcoModel::addConstraintGenerators() {
   int ipmFreq = dcoPar_->entry(DcoParams::cutIpmFreq);
   int ipmintFreq = dcoPar_->entry(DcoParams::cutIpmIntFreq);
   int oaFreq = dcoPar_->entry(DcoParams::cutOaFreq);
+  int conicMirFreq = dcoPar_->entry(DcoParams::conicCutMirFreq);
 
   //----------------------------------
   // Add cut generators.
@@ -1146,12 +2419,39 @@ void DcoModel::addConstraintGenerators() {
       oaStrategy = cutStrategy_;
     }
   }
-  if (oaStrategy != DcoCutStrategyNone && numConicRows_) {
+  if (oaStrategy != DcoCutStrategyNone && numConicRows_ &&
+      dcoPar_->entry(DcoParams::cutOaNative)) {
+    char const * name = dcoConstraintTypeName[DcoConstraintTypeOA];
+    conGenerators_[DcoConstraintTypeOA] =
+      new DcoConicOaGenerator(this, name, oaStrategy, oaFreq);
+  }
+  else if (oaStrategy != DcoCutStrategyNone && numConicRows_) {
     CglConicCutGenerator * oa_gen =
       new CglConicOA(dcoPar_->entry(DcoParams::coneTol));
     addConGenerator(oa_gen, DcoConstraintTypeOA, oaStrategy, oaFreq);
   }
 
+  // Add conic MIR cut generator
+  if (conicMirStrategy == DcoCutStrategyNotSet) {
+    if (cutStrategy_ == DcoCutStrategyNotSet) {
+      // Disable by default
+      conicMirStrategy = DcoCutStrategyNone;
+    }
+    else if (cutStrategy_ == DcoCutStrategyPeriodic) {
+      conicMirStrategy = cutStrategy_;
+      conicMirFreq = cutGenerationFrequency_;
+    }
+    else {
+      conicMirStrategy = cutStrategy_;
+    }
+  }
+  if (conicMirStrategy != DcoCutStrategyNone && numConicRows_ &&
+      numIntegerCols_) {
+    char const * name = dcoConstraintTypeName[DcoConstraintTypeCMIR];
+    conGenerators_[DcoConstraintTypeCMIR] =
+      new DcoConicMirGenerator(this, name, conicMirStrategy, conicMirFreq);
+  }
+
   // Adjust cutStrategy_ according to the strategies of each cut generators.
   // set it to the most allowing one.
   // if there is at least one periodic strategy, set it to periodic.
@@ -1214,7 +2514,15 @@ void DcoModel::addHeuristics() {
   // todo(aykut) this function (heuristic adding process) can be improved
   // since global parameters are ignored with this design.
 
+  if (heurExecutor_) {
+    delete heurExecutor_;
+    heurExecutor_ = NULL;
+  }
   heuristics_.clear();
+  if (localSearch_) {
+    delete localSearch_;
+    localSearch_ = NULL;
+  }
   // get global heuristic strategy
   heurStrategy_ = static_cast<DcoHeurStrategy>
     (dcoPar_->entry(DcoParams::heurStrategy));
@@ -1242,39 +2550,65 @@ void DcoModel::addHeuristics() {
   if (roundingStrategy != DcoHeurStrategyNone) {
     DcoHeuristic * round = new DcoHeurRounding(this, "rounding",
                                                roundingStrategy, roundingFreq);
+    round->setWorkLimit(dcoPar_->entry(DcoParams::heurRoundSweeps));
     heuristics_.push_back(round);
   }
+  // == add local search, it is called on new incumbents and does not
+  // affect the global strategy.
+  if (dcoPar_->entry(DcoParams::heurLocalSearch)) {
+    localSearch_ = new DcoHeurLocalSearch(this, "local search",
+                                          DcoHeurStrategyAuto, 1);
+    localSearch_->setWorkLimit(
+      dcoPar_->entry(DcoParams::heurLocalSearchPasses));
+  }
 
 
   // Adjust heurStrategy_ according to the strategies/frequencies of each
   // heuristic. Set it to the most allowing one.
-  // if there is at least one periodic strategy, set it to periodic.
+  // if there is at least one auto strategy, set it to auto. Frequencies of
+  // auto heuristics are adapted by DcoHeuristic::adapt() during search.
+  // if no auto and there is at least one periodic strategy, set it to
+  // periodic with the smallest frequency.
   // if no periodic and there is at least one root, set it to root
   // set it to None otherwise.
   heurStrategy_ = DcoHeurStrategyNone;
   heurFrequency_ = -1;
+  bool auto_exists = false;
   bool periodic_exists = false;
   bool root_exists = false;
   std::vector<DcoHeuristic*>::iterator it;
   for (it=heuristics_.begin(); it!=heuristics_.end(); ++it) {
     DcoHeurStrategy curr = (*it)->strategy();
-    if (curr==DcoHeurStrategyPeriodic) {
+    if (curr==DcoHeurStrategyAuto) {
+      auto_exists = true;
+    }
+    else if (curr==DcoHeurStrategyPeriodic) {
       periodic_exists = true;
-      break;
+      if (heurFrequency_==-1 or (*it)->frequency()<heurFrequency_) {
+        heurFrequency_ = (*it)->frequency();
+      }
     }
     else if (curr==DcoHeurStrategyRoot) {
       root_exists = true;
     }
   }
-  if (periodic_exists) {
-    heurStrategy_ = DcoHeurStrategyPeriodic;
+  if (auto_exists) {
+    heurStrategy_ = DcoHeurStrategyAuto;
     heurFrequency_ = 1;
   }
+  else if (periodic_exists) {
+    heurStrategy_ = DcoHeurStrategyPeriodic;
+  }
   else if (root_exists) {
     heurStrategy_ = DcoHeurStrategyRoot;
     // this is not relevant, since we will generate only in root.
     heurFrequency_ = -1;
   }
+
+  // run heuristics on a background thread if asked.
+  if (dcoPar_->entry(DcoParams::heurAsync) and !heuristics_.empty()) {
+    heurExecutor_ = new DcoHeurExecutor(this);
+  }
 }
 
 void DcoModel::setBranchingStrategy() {
@@ -1436,6 +2770,8 @@ DcoSolution * DcoModel::feasibleSolution(int & numInfColumns,
     // check feasibility
     int preferredDir;
     double infeas = curr->infeasibility(this, preferredDir);
+    // keep it, conic cut generators separate the violated rows only.
+    relaxedRowInf_[i] = infeas;
     if (infeas>0) {
       numInfRows++;
       if (rowInf<infeas) {
@@ -1443,6 +2779,7 @@ DcoSolution * DcoModel::feasibleSolution(int & numInfColumns,
       }
     }
   }
+  relaxedRowInfValid_ = true;
   // report largest column and row infeasibilities
   dcoMessageHandler_->message(DISCO_INFEAS_REPORT, *dcoMessages_)
     << broker()->getProcRank()
@@ -1467,6 +2804,571 @@ DcoSolution * DcoModel::feasibleSolution(int & numInfColumns,
   return dco_sol;
 }
 
+/// Orders relaxed rows by decreasing infeasibility, ties by index.
+struct DcoRowInfCompare {
+  double const * infeas_;
+  DcoRowInfCompare(double const * infeas): infeas_(infeas) { }
+  bool operator()(int a, int b) const {
+    if (infeas_[a]!=infeas_[b]) {
+      return infeas_[a]>infeas_[b];
+    }
+    return a<b;
+  }
+};
+
+void DcoModel::violatedRelaxedRows(double const * sol,
+                                   std::vector<double> & infeas,
+                                   std::vector<int> & rows) {
+  rows.clear();
+  // infeasibilities computed in feasibleSolution() for this solution, compute
+  // them here if they are out of date.
+  double const * row_inf = relaxedRowInf();
+  if (row_inf==NULL) {
+    double cone_tol = dcoPar_->entry(DcoParams::coneTol);
+    std::vector<BcpsConstraint*> & cons = getConstraints();
+    infeas.resize(numRelaxedRows_);
+    for (int i=0; i<numRelaxedRows_; ++i) {
+      DcoConicConstraint * con =
+        dynamic_cast<DcoConicConstraint*>(cons[relaxedRows_[i]]);
+      double value = con->infeasibility(sol);
+      infeas[i] = (value>cone_tol) ? value : 0.0;
+    }
+    if (numRelaxedRows_==0) {
+      return;
+    }
+    row_inf = &infeas[0];
+  }
+  for (int i=0; i<numRelaxedRows_; ++i) {
+    if (row_inf[i]>0.0) {
+      rows.push_back(i);
+    }
+  }
+  std::sort(rows.begin(), rows.end(), DcoRowInfCompare(row_inf));
+  int max_rows = dcoPar_->entry(DcoParams::cutOaMaxCones);
+  if (max_rows>0 and static_cast<int>(rows.size())>max_rows) {
+    rows.resize(max_rows);
+  }
+}
+
+DcoSolution * DcoModel::polishSolution(DcoSolution const * sol) {
+  double polish_tol = dcoPar_->entry(DcoParams::polishConeTol);
+  double const * values = sol->getValues();
+  // fix integer columns to their rounded values
+  double * fixed = new double[numIntegerCols_];
+  for (int i=0; i<numIntegerCols_; ++i) {
+    fixed[i] = floor(values[integerCols_[i]] + 0.5);
+  }
+  DcoSolution * resolved = solveFixed(numIntegerCols_, integerCols_, fixed);
+  delete[] fixed;
+  DcoSolution * polished = NULL;
+  if (resolved) {
+    double col_inf, row_inf, cone_inf, sol_cone_inf;
+    checkSolution(resolved->getValues(), col_inf, row_inf, cone_inf);
+    checkSolution(sol->getValues(), col_inf, row_inf, sol_cone_inf);
+    // In OA builds the objective value of sol is the value of the
+    // approximation, the polished value is the true one even when it is
+    // worse. Compare them only if sol is as accurate as the polished point.
+    bool accept = cone_inf<=polish_tol;
+    if (accept and sol_cone_inf<=polish_tol) {
+      accept = objSense_*resolved->getQuality()<=objSense_*sol->getQuality();
+    }
+    if (accept) {
+      polished = resolved;
+      resolved = NULL;
+      dcoMessageHandler_->message(DISCO_HEUR_POLISHED, *dcoMessages_)
+        << broker()->getProcRank()
+        << sol->getQuality()
+        << polished->getQuality()
+        << cone_inf
+        << CoinMessageEol;
+    }
+  }
+  if (resolved) {
+    delete resolved;
+  }
+  return polished;
+}
+
+DcoSolution * DcoModel::solveFixed(int numFixed, int const * cols,
+                                   double const * values) {
+  // work on a copy of the solver, it has the current node subproblem.
+#if defined(__OA__)
+  OsiSolverInterface * solver = solver_->clone(true);
+#else
+  OsiConicSolverInterface * solver =
+    dynamic_cast<OsiConicSolverInterface*>(solver_->clone(true));
+#endif
+  // remove node cuts, rows after the linear rows and the approximation
+  // cuts, and restore global bounds.
+  int num_core_rows = numLinearRows_;
+#if defined(__OA__)
+  num_core_rows += initOAcuts_;
+#endif
+  int num_cuts = solver->getNumRows() - num_core_rows;
+  if (num_cuts>0) {
+    int * cut_rows = new int[num_cuts];
+    CoinIotaN(cut_rows, num_cuts, num_core_rows);
+    solver->deleteRows(num_cuts, cut_rows);
+    delete[] cut_rows;
+  }
+  std::vector<BcpsVariable*> & vars = getVariables();
+  for (int i=0; i<numCols_; ++i) {
+    solver->setColBounds(i, vars[i]->getLbHard(), vars[i]->getUbHard());
+  }
+  for (int i=0; i<numFixed; ++i) {
+    solver->setColBounds(cols[i], values[i], values[i]);
+  }
+  solver->resolve();
+#if defined(__OA__)
+  // OA loop with tight tolerance, integers are fixed so this converges to
+  // the conic optimum of the continuous columns.
+  double polish_tol = dcoPar_->entry(DcoParams::polishConeTol);
+  int num_pass = dcoPar_->entry(DcoParams::polishNumPass);
+  CglConicCutGenerator * cg_oa = new CglConicOA(polish_tol);
+  for (int pass=0; pass<num_pass and solver->isProvenOptimal(); ++pass) {
+    OsiCuts * oa_cuts = new OsiCuts();
+    cg_oa->generateCuts(*solver, *oa_cuts, numConicRows_, coneOsiType_,
+                        coneSize_, coneMemberPtr_, 1);
+    int num_cuts = oa_cuts->sizeRowCuts();
+    if (num_cuts==0) {
+      delete oa_cuts;
+      break;
+    }
+    solver->applyCuts(*oa_cuts);
+    solver->resolve();
+    delete oa_cuts;
+  }
+  delete cg_oa;
+#endif
+  DcoSolution * dco_sol = NULL;
+  if (solver->isProvenOptimal()) {
+    dco_sol = new DcoSolution(numCols_, solver->getColSolution(),
+                              solver->getObjValue());
+    dco_sol->setBroker(broker_);
+  }
+  delete solver;
+  return dco_sol;
+}
+
+bool DcoModel::checkSolution(double const * sol, double & colInf,
+                             double & rowInf, double & coneInf) {
+  double int_tol = dcoPar_->entry(DcoParams::integerTol);
+  double cone_tol = dcoPar_->entry(DcoParams::coneTol);
+  double primal_tol;
+  solver_->getDblParam(OsiPrimalTolerance, primal_tol);
+  colInf = 0.0;
+  rowInf = 0.0;
+  coneInf = 0.0;
+  bool feasible = true;
+  // column bounds and integrality, hard bounds are the bounds of the
+  // original problem.
+  std::vector<BcpsVariable*> & cols = getVariables();
+  for (int i=0; i<numCols_; ++i) {
+    double value = sol[i];
+    double infeas = CoinMax(cols[i]->getLbHard() - value,
+                            value - cols[i]->getUbHard());
+    if (infeas>primal_tol) {
+      feasible = false;
+    }
+    if (isInteger_[i]) {
+      double int_infeas = fabs(value - floor(value + 0.5));
+      if (int_infeas>=int_tol) {
+        feasible = false;
+      }
+      infeas = CoinMax(infeas, int_infeas);
+    }
+    colInf = CoinMax(colInf, infeas);
+  }
+  // linear and conic rows, same kernels used by the constraint objects.
+  std::vector<BcpsConstraint*> & rows = getConstraints();
+  for (int i=0; i<numLinearRows_; ++i) {
+    DcoLinearConstraint * con = dynamic_cast<DcoLinearConstraint*>(rows[i]);
+    rowInf = CoinMax(rowInf, con->infeasibility(sol));
+  }
+  if (rowInf>primal_tol) {
+    feasible = false;
+  }
+  for (int i=numLinearRows_; i<numLinearRows_+numConicRows_; ++i) {
+    DcoConicConstraint * con = dynamic_cast<DcoConicConstraint*>(rows[i]);
+    coneInf = CoinMax(coneInf, con->infeasibility(sol));
+  }
+  if (coneInf>cone_tol) {
+    feasible = false;
+  }
+  return feasible;
+}
+
+bool DcoModel::setMipStart(int size, int const * indices,
+                           double const * values) {
+  // indices are in terms of the original problem.
+  int num_cols = presolve_ ? presolve_->numOrigCols() : numCols_;
+  std::vector<bool> given(num_cols, false);
+  for (int i=0; i<size; ++i) {
+    if (indices[i]<0 or indices[i]>=num_cols) {
+      dcoMessageHandler_->message(DISCO_MIPSTART_BADINDEX, *dcoMessages_)
+        << indices[i]
+        << num_cols
+        << CoinMessageEol;
+      return false;
+    }
+    if (given[indices[i]]) {
+      dcoMessageHandler_->message(DISCO_MIPSTART_DUPINDEX, *dcoMessages_)
+        << indices[i]
+        << CoinMessageEol;
+      return false;
+    }
+    given[indices[i]] = true;
+  }
+  if (mipStartInd_) {
+    delete[] mipStartInd_;
+  }
+  if (mipStartVal_) {
+    delete[] mipStartVal_;
+  }
+  mipStartSize_ = size;
+  mipStartInd_ = new int[size];
+  std::copy(indices, indices+size, mipStartInd_);
+  mipStartVal_ = new double[size];
+  std::copy(values, values+size, mipStartVal_);
+  if (presolve_) {
+    presolveMipStart();
+  }
+  // variables are created in setupSelf(), if it is already called process
+  // the start now.
+  if (getVariables().size() and
+      (broker_->getProcType()==AlpsProcessTypeMaster or
+       broker_->getProcType()==AlpsProcessTypeSerial)) {
+    processMipStart();
+  }
+  return true;
+}
+
+bool DcoModel::readMipStart(char const * file) {
+  std::ifstream start_file(file);
+  if (!start_file.is_open()) {
+    dcoMessageHandler_->message(DISCO_MIPSTART_OPENERROR, *dcoMessages_)
+      << file
+      << CoinMessageEol;
+    return false;
+  }
+  // indices are in terms of the original problem.
+  int num_cols = presolve_ ? presolve_->numOrigCols() : numCols_;
+  std::vector<int> indices;
+  std::vector<double> values;
+  std::string line;
+  int line_number = 0;
+  while (std::getline(start_file, line)) {
+    line_number++;
+    // strip comments
+    std::string::size_type comment = line.find('#');
+    if (comment!=std::string::npos) {
+      line.erase(comment);
+    }
+    if (line.find_first_not_of(" \t\r")==std::string::npos) {
+      continue;
+    }
+    std::istringstream line_stream(line);
+    int index;
+    double value;
+    std::string rest;
+    if (!(line_stream >> index >> value) or (line_stream >> rest) or
+        index<0 or index>=num_cols) {
+      dcoMessageHandler_->message(DISCO_MIPSTART_LINEERROR, *dcoMessages_)
+        << file
+        << line_number
+        << CoinMessageEol;
+      return false;
+    }
+    indices.push_back(index);
+    values.push_back(value);
+  }
+  if (indices.empty()) {
+    return false;
+  }
+  return setMipStart(indices.size(), &indices[0], &values[0]);
+}
+
+void DcoModel::processMipStart() {
+  dcoMessageHandler_->message(DISCO_MIPSTART_READ, *dcoMessages_)
+    << mipStartSize_
+    << numCols_
+    << CoinMessageEol;
+  double col_inf, row_inf, cone_inf;
+  // a start that gives every column is tried as it is first, the continuous
+  // solve is only needed if it is not feasible.
+  if (mipStartSize_==numCols_) {
+    std::vector<double> point(numCols_);
+    for (int i=0; i<mipStartSize_; ++i) {
+      point[mipStartInd_[i]] = mipStartVal_[i];
+    }
+    if (checkSolution(&point[0], col_inf, row_inf, cone_inf)) {
+      double const * obj = solver_->getObjCoefficients();
+      double quality = std::inner_product(point.begin(), point.end(), obj,
+                                          0.0);
+      DcoSolution * sol = new DcoSolution(numCols_, &point[0], quality);
+      sol->setBroker(broker_);
+      dcoMessageHandler_->message(DISCO_MIPSTART_ACCEPTED, *dcoMessages_)
+        << quality
+        << CoinMessageEol;
+      // values may be feasible to tolerances only, polish as heuristic
+      // solutions are.
+      sol = polishCandidate(sol);
+      sol->setDepth(0);
+      storeSolution(sol, "MIP start");
+      return;
+    }
+  }
+  // round integer values, continuous values are used as given.
+  double * values = new double[mipStartSize_];
+  for (int i=0; i<mipStartSize_; ++i) {
+    double value = mipStartVal_[i];
+    values[i] = isInteger_[mipStartInd_[i]] ? floor(value + 0.5) : value;
+  }
+  // complete the start with the continuous solve. If some of the integer
+  // columns are not given the result may be fractional in these columns,
+  // round them and solve once more with every integer column fixed.
+  DcoSolution * sol = solveFixed(mipStartSize_, mipStartInd_, values);
+  delete[] values;
+  if (sol and !checkSolution(sol->getValues(), col_inf, row_inf, cone_inf)
+      and mipStartSize_<numCols_) {
+    double * fixed = new double[numIntegerCols_];
+    for (int i=0; i<numIntegerCols_; ++i) {
+      fixed[i] = floor(sol->getValues()[integerCols_[i]] + 0.5);
+    }
+    delete sol;
+    sol = solveFixed(numIntegerCols_, integerCols_, fixed);
+    delete[] fixed;
+  }
+  if (sol==NULL) {
+    dcoMessageHandler_->message(DISCO_MIPSTART_FAILED, *dcoMessages_)
+      << CoinMessageEol;
+    return;
+  }
+  if (!checkSolution(sol->getValues(), col_inf, row_inf, cone_inf)) {
+    dcoMessageHandler_->message(DISCO_MIPSTART_REJECTED, *dcoMessages_)
+      << col_inf
+      << row_inf
+      << cone_inf
+      << CoinMessageEol;
+    delete sol;
+    return;
+  }
+  dcoMessageHandler_->message(DISCO_MIPSTART_ACCEPTED, *dcoMessages_)
+    << sol->getQuality()
+    << CoinMessageEol;
+  sol->setDepth(0);
+  storeSolution(sol, "MIP start");
+}
+
+// The broker owns a solution once it is stored and its pool may free it any
+// time after, everything that reads sol is done before addKnowledge().
+void DcoModel::storeSolution(DcoSolution * sol, std::string const & source,
+                             bool improve) {
+  double value = objSense_*sol->getQuality();
+  bool incumbent = value<broker()->getIncumbentValue();
+  double cutoff = dcoPar_->entry(DcoParams::cutoff);
+  if (cutoff!=ALPS_INC_MAX) {
+    if (presolve_) {
+      cutoff -= presolve_->objOffset();
+    }
+    incumbent = incumbent and value<=objSense_*cutoff;
+  }
+  DcoSolution * improved = NULL;
+  if (incumbent) {
+    reportIncumbent(sol, source);
+    if (improve) {
+      improved = improveSolution(sol);
+    }
+  }
+  sol->setIndex(broker()->getNumKnowledges(AlpsKnowledgeTypeSolution));
+  // Store in Alps pool, broker owns sol after this point.
+  broker()->addKnowledge(AlpsKnowledgeTypeSolution, sol, value);
+  // update solver with the new incumbent
+  double incum_val = broker()->getIncumbentValue();
+  solver_->setDblParam(OsiDualObjectiveLimit, objSense_*incum_val);
+  if (improved) {
+    dcoMessageHandler_->message(DISCO_HEUR_SOL_FOUND, *dcoMessages_)
+      << broker()->getProcRank()
+      << localSearch_->name()
+      << improved->getQuality()
+      << CoinMessageEol;
+    storeSolution(improved, localSearch_->name(), false);
+  }
+}
+
+DcoSolution * DcoModel::polishCandidate(DcoSolution * sol) {
+  if (!dcoPar_->entry(DcoParams::polish)) {
+    return sol;
+  }
+  if (objSense_*sol->getQuality() >= broker()->getIncumbentValue()) {
+    // not going to be the incumbent, the true value is not better than the
+    // approximate one, do not bother
+    return sol;
+  }
+  DcoSolution * polished = polishSolution(sol);
+  if (polished==NULL) {
+    return sol;
+  }
+  delete sol;
+  return polished;
+}
+
+void DcoModel::storeHeuristicSolution(DcoHeuristic const * heur,
+                                      DcoSolution * sol) {
+  int depth = sol->getDepth();
+  sol = polishCandidate(sol);
+  sol->setDepth(depth);
+  // debug log
+  dcoMessageHandler_->message(DISCO_HEUR_SOL_FOUND, *dcoMessages_)
+    << broker()->getProcRank()
+    << heur->name()
+    << sol->getQuality()
+    << CoinMessageEol;
+  // Store in Alps pool, broker owns sol after this point.
+  storeSolution(sol, heur->name());
+}
+
+void DcoModel::collectHeuristicSolutions() {
+  if (heurExecutor_==NULL) {
+    return;
+  }
+  // the last snapshot may still be running, its solutions count too.
+  heurExecutor_->wait();
+  DcoHeuristic * finder = NULL;
+  DcoSolution * sol = heurExecutor_->popSolution(finder);
+  while (sol) {
+    storeHeuristicSolution(finder, sol);
+    sol = heurExecutor_->popSolution(finder);
+  }
+}
+
+DcoSolution * DcoModel::improveSolution(DcoSolution const * sol) {
+  if (localSearch_==NULL) {
+    return NULL;
+  }
+  double start_time = CoinCpuTime();
+  DcoSolution * improved = localSearch_->improveSolution(sol);
+  localSearch_->stats().addCall(CoinCpuTime() - start_time, improved!=NULL);
+  if (improved==NULL) {
+    return NULL;
+  }
+  // local search moves integer columns only, resolve for the continuous
+  // ones. Polished value is the true one, it replaces the estimate.
+  if (dcoPar_->entry(DcoParams::polish)) {
+    DcoSolution * polished = polishSolution(improved);
+    if (polished) {
+      delete improved;
+      improved = polished;
+    }
+  }
+  improved->setDepth(sol->getDepth());
+  return improved;
+}
+
+// One line per incumbent, a JSON object, flushed so that readers see it
+// immediately. Gap is null when there is no node to bound it.
+void DcoModel::reportIncumbent(DcoSolution const * sol,
+                               std::string const & source) {
+  std::string file = dcoPar_->entry(DcoParams::incumbentFile);
+  double incumbent = objSense_*sol->getQuality();
+  if (file.empty()) {
+    return;
+  }
+  if (incumbentStream_==NULL) {
+    // each process of a parallel run writes its own file.
+    if (broker()->getProcType()!=AlpsProcessTypeSerial) {
+      std::stringstream name;
+      name << file << "." << broker()->getProcRank();
+      file = name.str();
+    }
+    incumbentStream_ = new std::ofstream(file.c_str());
+    if (!incumbentStream_->is_open()) {
+      dcoMessageHandler_->message(DISCO_INCUMBENT_WRITEERROR, *dcoMessages_)
+        << file << CoinMessageEol;
+    }
+  }
+  if (!incumbentStream_->is_open()) {
+    return;
+  }
+  std::ostream & out = *incumbentStream_;
+  out.precision(17);
+  out << "{\"time\": " << broker()->timer().getWallClock()
+      << ", \"source\": \"" << source << "\""
+      << ", \"objective\": " << objSense_*incumbent + objConstant_
+      << ", \"gap\": ";
+  AlpsTreeNode * best_node = broker()->getBestNode();
+  if (best_node) {
+    double lb = CoinMin(best_node->getQuality(), incumbent);
+    out << 100.0*(incumbent-lb)/CoinMax(fabs(incumbent), 1e-10);
+  }
+  else {
+    out << "null";
+  }
+  out << ", \"nodes\": " << broker()->getNumNodesProcessed()
+      << ", \"x\": [";
+  // only the process that presolved can postsolve, others write the values
+  // of the presolved problem.
+  std::vector<double> values;
+  postsolve(sol, values);
+  bool first = true;
+  for (unsigned int i=0; i<values.size(); ++i) {
+    if (values[i]!=0.0) {
+      out << (first ? "" : ", ") << "[" << i << ", " << values[i] << "]";
+      first = false;
+    }
+  }
+  out << "]}" << std::endl;
+}
+
+void DcoModel::postsolve(DcoSolution const * sol,
+                         std::vector<double> & values) const {
+  if (presolve_==NULL) {
+    values.assign(sol->getValues(), sol->getValues()+sol->getSize());
+    return;
+  }
+  values.resize(presolve_->numOrigCols());
+  presolve_->postsolve(sol->getValues(), &values[0]);
+}
+
+bool DcoModel::writeSolution(char const * file) {
+  // master has the best solution of a parallel search at the end.
+  if (broker()->getProcType()!=AlpsProcessTypeSerial and
+      broker()->getProcType()!=AlpsProcessTypeMaster) {
+    return false;
+  }
+  if (!broker()->hasKnowledge(AlpsKnowledgeTypeSolution)) {
+    return false;
+  }
+  DcoSolution * best = dynamic_cast<DcoSolution*>
+    (broker()->getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+  std::ofstream out(file);
+  if (!out.is_open()) {
+    dcoMessageHandler_->message(DISCO_SOLUTION_WRITEERROR, *dcoMessages_)
+      << file << CoinMessageEol;
+    return false;
+  }
+  out.precision(17);
+  out << "# problem " << problemName_ << "\n";
+  out << "# objective " << objSense_*broker()->getIncumbentValue() +
+    objConstant_ << "\n";
+  std::vector<double> values;
+  postsolve(best, values);
+  for (unsigned int i=0; i<values.size(); ++i) {
+    if (values[i]!=0.0) {
+      out << i << " " << values[i] << "\n";
+    }
+  }
+  out.close();
+  if (out.fail()) {
+    dcoMessageHandler_->message(DISCO_SOLUTION_WRITEERROR, *dcoMessages_)
+      << file << CoinMessageEol;
+    return false;
+  }
+  dcoMessageHandler_->message(DISCO_SOLUTION_WRITTEN, *dcoMessages_)
+    << file << CoinMessageEol;
+  return true;
+}
+
 //todo(aykut) When all node bounds are worse than incumbent solution
 // this function reports negative gap.
 // this happens since Alps takes nodes that will be fathomed into account,
@@ -1580,11 +3482,21 @@ void DcoModel::modelLog() {
           << curr->stats().numConsGenerated()
           << curr->stats().numConsUsed()
           << curr->stats().time()
+          << curr->stats().objImp()
           << curr->strategy()
           << CoinMessageEol;
       }
     }
     // report heuristic statistics
+    if (heurExecutor_) {
+      // let the worker finish, it updates heuristic statistics. Solutions
+      // it found after the last node are stored before they are reported.
+      collectHeuristicSolutions();
+      dcoMessageHandler_->message(DISCO_HEUR_ASYNC_STATS, *dcoMessages_)
+        << heurExecutor_->numJobs()
+        << heurExecutor_->numDropped()
+        << CoinMessageEol;
+    }
     for (unsigned int k=0; k<heuristics_.size(); ++k) {
       if (heuristics(k)->stats().numCalls() > 0) {
         dcoMessageHandler_->message(DISCO_HEUR_STATS_FINAL,
@@ -1597,6 +3509,36 @@ void DcoModel::modelLog() {
           << CoinMessageEol;
       }
     }
+    if (localSearch_ and localSearch_->stats().numCalls() > 0) {
+      dcoMessageHandler_->message(DISCO_HEUR_STATS_FINAL, *dcoMessages_)
+        << localSearch_->name()
+        << localSearch_->stats().numCalls()
+        << localSearch_->stats().numSolutions()
+        << localSearch_->stats().time()
+        << localSearch_->strategy()
+        << CoinMessageEol;
+    }
+    if (propagator_ and propagator_->numCalls() > 0) {
+      dcoMessageHandler_->message(DISCO_PROPAGATION_STATS, *dcoMessages_)
+        << propagator_->numCalls()
+        << propagator_->numInfeasible()
+        << propagator_->numTightened()
+        << CoinMessageEol;
+    }
+    if (numRcFixedGlobal_ > 0 or numRcFixedNode_ > 0) {
+      dcoMessageHandler_->message(DISCO_RCFIX_STATS, *dcoMessages_)
+        << numRcFixedGlobal_
+        << numRcFixedNode_
+        << CoinMessageEol;
+    }
+    // solution values reported by Alps are without the objective constant.
+    if (objConstant_!=0.0 and
+        broker()->hasKnowledge(AlpsKnowledgeTypeSolution)) {
+      dcoMessageHandler_->message(DISCO_OBJ_CONSTANT, *dcoMessages_)
+        << objConstant_
+        << objSense_*broker()->getIncumbentValue() + objConstant_
+        << CoinMessageEol;
+    }
   }
   else if (broker_->getProcType()==AlpsProcessTypeMaster) {
     dcoMessageHandler_->message(0, "Dco",
@@ -1761,6 +3703,7 @@ AlpsReturnStatus DcoModel::encode(AlpsEncoded * encoded) const {
   encoded->writeRep(rowUB_, numRows_);
   encoded->writeRep(objSense_);
   encoded->writeRep(objCoef_, numCols_);
+  encoded->writeRep(objConstant_);
   encoded->writeRep(numIntegerCols_);
   encoded->writeRep(integerCols_, numIntegerCols_);
   encoded->writeRep(isInteger_, numCols_);
@@ -1777,6 +3720,17 @@ AlpsReturnStatus DcoModel::encode(AlpsEncoded * encoded) const {
   encoded->writeRep(matrix_->getIndices(), matrix_->getNumElements());
   encoded->writeRep(matrix_->getElements(), matrix_->getNumElements());
   encoded->writeRep(initOAcuts_);
+  if (initOAcuts_) {
+    encoded->writeRep(initOAcutRows_->getNumElements());
+    encoded->writeRep(initOAcutRows_->getVectorStarts(), initOAcuts_);
+    encoded->writeRep(initOAcutRows_->getVectorLengths(), initOAcuts_);
+    encoded->writeRep(initOAcutRows_->getIndices(),
+                      initOAcutRows_->getNumElements());
+    encoded->writeRep(initOAcutRows_->getElements(),
+                      initOAcutRows_->getNumElements());
+    encoded->writeRep(initOAcutLB_, initOAcuts_);
+    encoded->writeRep(initOAcutUB_, initOAcuts_);
+  }
   // encode parameters
   dcoPar_->pack(*encoded);
 
@@ -1825,6 +3779,7 @@ AlpsReturnStatus DcoModel::decodeToSelf(AlpsEncoded & encoded) {
   encoded.readRep(rowUB_, numRows_);
   encoded.readRep(objSense_);
   encoded.readRep(objCoef_, numCols_);
+  encoded.readRep(objConstant_);
   encoded.readRep(numIntegerCols_);
   encoded.readRep(integerCols_, numIntegerCols_);
   encoded.readRep(isInteger_, numCols_);
@@ -1854,6 +3809,22 @@ AlpsReturnStatus DcoModel::decodeToSelf(AlpsEncoded & encoded) {
   delete[] lengths;
   delete[] indices;
   delete[] elements;
+  if (initOAcuts_) {
+    encoded.readRep(num_elem);
+    encoded.readRep(starts, initOAcuts_);
+    encoded.readRep(lengths, initOAcuts_);
+    encoded.readRep(indices, num_elem);
+    encoded.readRep(elements, num_elem);
+    initOAcutRows_ = new CoinPackedMatrix(false, numCols_, initOAcuts_,
+                                          num_elem, elements, indices, starts,
+                                          lengths, 0.0, 0.0);
+    encoded.readRep(initOAcutLB_, initOAcuts_);
+    encoded.readRep(initOAcutUB_, initOAcuts_);
+    delete[] starts;
+    delete[] lengths;
+    delete[] indices;
+    delete[] elements;
+  }
   dcoPar_->unpack(encoded);
 
   // debug stuff
@@ -1871,3 +3842,19 @@ AlpsReturnStatus DcoModel::decodeToSelf(AlpsEncoded & encoded) {
 void DcoModel::addNumRelaxIterations() {
   numRelaxIterations_ += solver_->getIterationCount();
 }
+
+/// Branching rate is not used before this many children are measured.
+static int const dcoMinBranchSamples = 10;
+
+void DcoModel::addBranchSample(double imp, double time) {
+  branchImp_ += imp;
+  branchTime_ += time;
+  numBranchSamples_++;
+}
+
+double DcoModel::branchRate() const {
+  if (numBranchSamples_<dcoMinBranchSamples) {
+    return 0.0;
+  }
+  return branchImp_/(2.0*CoinMax(branchTime_, 1.0e-6));
+}
@@ -6,6 +6,8 @@
 #include <OsiLorentzCone.hpp>
 #include <BcpsBranchStrategy.h>
 
+#include <vector>
+#include <iosfwd>
 
 #include "DcoParams.hpp"
 #include "DcoConstraint.hpp"
@@ -13,6 +15,11 @@
 class DcoConGenerator;
 class DcoSolution;
 class DcoHeuristic;
+class DcoHeurExecutor;
+class DcoHeurLocalSearch;
+class DcoImplications;
+class DcoPresolve;
+class DcoPropagator;
 
 class CglCutGenerator;
 class CglConicCutGenerator;
@@ -54,6 +61,11 @@ class CglConicCutGenerator;
    DcoConicConGenerator implements generating supports for conic
    constraints. Constructor takes a CglConicCutGenerator as an input.
 
+   DcoConicOaGenerator implements OA cuts for conic constraints without Cgl,
+   it is used instead of CglConicOA when cutOaNative is true.
+
+   DcoConicMirGenerator implements conic mixed integer rounding cuts.
+
    # Heuristics
 
    # setupSelf()
@@ -112,6 +124,18 @@ class DcoModel: public BcpsModel {
   int * coneType_;
   //@}
 
+  ///@name Cone data in the form conic Cgl generators take. Built once by
+  /// setupConeData() from the fields above, member pointers point into
+  /// coneMembers_.
+  //@{
+  /// Osi types of cones.
+  OsiLorentzConeType * coneOsiType_;
+  /// Sizes of cones.
+  int * coneSize_;
+  /// coneMemberPtr_[i] is the array of members of cone i.
+  int const ** coneMemberPtr_;
+  //@}
+
   ///@name Number of columns and rows
   //@{
   /// Number of columns.
@@ -128,6 +152,9 @@ class DcoModel: public BcpsModel {
   //@{
   double objSense_;
   double * objCoef_;
+  /// Constant term of the objective. It is not passed to the solver, solution
+  /// qualities do not include it.
+  double objConstant_;
   //@}
 
   ///@name Column types
@@ -169,6 +196,11 @@ class DcoModel: public BcpsModel {
   int numRelaxedRows_;
   /// Array of indices to relaxed rows.
   int * relaxedRows_;
+  /// Infeasibility of relaxed rows computed by the last feasibleSolution()
+  /// call, 0 for the feasible ones. Size of numRelaxedRows_.
+  double * relaxedRowInf_;
+  /// Whether relaxedRowInf_ corresponds to the current solver solution.
+  bool relaxedRowInfValid_;
   //@}
 
   ///@name Heuristics
@@ -176,6 +208,12 @@ class DcoModel: public BcpsModel {
   DcoHeurStrategy heurStrategy_;
   int heurFrequency_;
   std::vector<DcoHeuristic*> heuristics_;
+  /// Runs heuristics on a background thread, NULL unless Dco_heurAsync is
+  /// set.
+  DcoHeurExecutor * heurExecutor_;
+  /// Improves every new incumbent, NULL unless Dco_heurLocalSearch is set.
+  /// It is not in heuristics_ since it is not called at nodes.
+  DcoHeurLocalSearch * localSearch_;
   //@}
 
   ///@name Cut generator related.
@@ -194,10 +232,66 @@ class DcoModel: public BcpsModel {
   /// Current number of approximation cuts in solver added by
   /// #approximateCones().
   int initOAcuts_;
+  /// Rows of the approximation cuts found by #approximateCones(), row
+  /// ordered. setupSelf() adds them to the solver after the linear rows.
+  CoinPackedMatrix * initOAcutRows_;
+  /// Lower bounds of #initOAcutRows_.
+  double * initOAcutLB_;
+  /// Upper bounds of #initOAcutRows_.
+  double * initOAcutUB_;
+  /// True if the instance is read from a snapshot, preprocess() is done
+  /// already.
+  bool preprocessed_;
+  /// Implications and global bound changes found by probing.
+  DcoImplications * implications_;
+  /// Presolve of the problem read, NULL if Dco_presolve is not set. Keeps
+  /// what is needed to map solutions back to the original columns.
+  DcoPresolve * presolve_;
+  /// Bound propagation run on the nodes, NULL if Dco_propagate is not set.
+  DcoPropagator * propagator_;
+  //@}
+
+  ///@name MIP start
+  //@{
+  /// Number of columns with a MIP start value.
+  int mipStartSize_;
+  /// Indices of the columns in the MIP start.
+  int * mipStartInd_;
+  /// MIP start values, in the order of #mipStartInd_.
+  double * mipStartVal_;
   //@}
 
   /// Number of relaxation iterations.
   long long int numRelaxIterations_;
+
+  ///@name Branching progress, used by cut loop tailing-off control.
+  //@{
+  /// Total bound improvement of children over their parents.
+  double branchImp_;
+  /// Total time spent for the first bounding of children.
+  double branchTime_;
+  /// Number of children measured.
+  int numBranchSamples_;
+  //@}
+
+  ///@name Reduced cost fixing statistics
+  //@{
+  /// Number of global bounds tightened at the root.
+  int numRcFixedGlobal_;
+  /// Number of bounds tightened at the other nodes.
+  int numRcFixedNode_;
+  //@}
+
+  /// Stream of Dco_incumbentFile, opened at the first incumbent.
+  std::ofstream * incumbentStream_;
+
+  ///@name Result of solve()
+  //@{
+  /// Best solution found, empty if there is none.
+  std::vector<double> bestSolution_;
+  /// Objective value of the best solution, objective constant included.
+  double bestObjValue_;
+  //@}
   ///==========================================================================
 
 
@@ -210,20 +304,61 @@ class DcoModel: public BcpsModel {
   void setupAddLinearConstraints();
   /// Add conic constraints to the model. Helps readInstance function.
   void setupAddConicConstraints();
+  /// Log cone statistics and problem information of the problem read or
+  /// loaded.
+  void logProblemInfo();
   //@}
 
   ///@name Setup Helpers
   //@{
   /// Set log levels, Alps, Bcps and Disco
   void setMessageLevel();
+  /// Build cone data for Cgl generators, does nothing if it is already
+  /// built.
+  void setupConeData();
+  /// Presolve the fields set by readInstance() with DcoPresolve and replace
+  /// them with the reduced problem. Objective value of the removed columns
+  /// is added to the objective constant. Model is not changed if presolve
+  /// finds the problem infeasible.
+  void presolve();
+  /// Map the MIP start indices from the original problem to the presolved
+  /// one, values of removed columns are dropped.
+  void presolveMipStart();
+  /// Replace cones with their extended (disaggregated) formulation. Lorentz
+  /// cone x_1 >= ||x_2n|| becomes 2x_1t_i >= x_i^2 for i=2..n and
+  /// 2(t_2+...+t_n) <= x_1, rotated cone 2x_1x_2 >= ||x_3n||^2 becomes
+  /// 2x_1t_i >= x_i^2 for i=3..n and t_3+...+t_n <= x_2. New columns t_i and
+  /// rows are appended, indices of the existing columns and rows do not
+  /// change. Works on the fields set by readInstance().
+  void extendCones();
+  /// Add Ben-Tal--Nemirovski polyhedral approximation of every cone to the
+  /// linear rows. Accuracy is Dco_approxFactor, ||x_2n|| <= (1+eps)x_1 for
+  /// the points of the approximation of Lorentz cone x_1 >= ||x_2n||. Cones
+  /// are kept, they are still relaxed and separated in OA builds. New columns
+  /// and rows are appended. Works on the fields set by readInstance().
+  void approximateConesBtn();
   /// Set branching strategy from parameters.
   void setBranchingStrategy();
   /// Add constraint generators with respect to parameters.
   void addConstraintGenerators();
   /// Add heuristics
   void addHeuristics();
+  /// Check the MIP start and give it to the broker as the incumbent if it
+  /// is feasible and gives every column. Otherwise complete it by solving
+  /// the continuous problem with the given columns fixed. Solver cutoff is
+  /// updated with the incumbent.
+  void processMipStart();
   //@}
 
+  /// Fix the given columns to the given values in a copy of the solver and
+  /// resolve. Cuts are removed from the copy and the columns get their
+  /// global bounds, so the result does not depend on the node the solver
+  /// has. In OA builds the cones are approximated with an OA loop to
+  /// Dco_polishConeTol. Returns the solution of the copy or NULL if it is
+  /// not proven optimal. Caller owns the returned solution.
+  DcoSolution * solveFixed(int numFixed, int const * cols,
+                           double const * values);
+
   /// write parameters to oustream
   void writeParameters(std::ostream& outstream) const;
 
@@ -274,6 +409,8 @@ public:
   BcpsBranchStrategy * branchStrategy() {return branchStrategy_;}
   /// return Dco Parameter
   DcoParams const * dcoPar() const {return dcoPar_;}
+  /// return Dco Parameter, for setting parameters before the search
+  DcoParams * dcoPar() {return dcoPar_;}
   /// get upper bound of the objective value for minimization
   double bestQuality();
   /// Accumulate number of relaxation iterations
@@ -282,6 +419,18 @@ public:
   void addNumRelaxIterations();
   /// Get number of relaxation iterations
   long long int numRelaxIterations() const {return numRelaxIterations_;}
+  /// Record that the first bounding of a child took time (wall clock, as cut
+  /// rounds) and improved the bound of its parent by imp.
+  void addBranchSample(double imp, double time);
+  /// Get bound improvement per second branching gives, 0 if there are not
+  /// enough samples yet. A branching creates two children, its rate is half
+  /// of the average rate of children.
+  double branchRate() const;
+  /// Record num bounds tightened by reduced cost fixing, global is true for
+  /// the root.
+  void addNumRcFixed(bool global, int num) {
+    (global ? numRcFixedGlobal_ : numRcFixedNode_) += num;
+  }
   //@}
 
   ///@name Querry problem data
@@ -302,6 +451,8 @@ public:
   double * rowUB() {return rowUB_;}
   /// Get objective sense, 1 for min, -1 for max
   double objSense() const { return objSense_; }
+  /// Get constant term of the objective.
+  double objConstant() const { return objConstant_; }
   /// Get number of integer variables.
   int numIntegerCols() const { return numIntegerCols_; }
   /// Get indices of integer variables. Size of numIntegerCols().
@@ -309,6 +460,13 @@ public:
   int const * coneStart() const { return coneStart_; }
   int const * coneMembers() const { return coneMembers_; }
   int const * coneType() const { return coneType_; }
+  /// Get Osi types of cones. Size of getNumCoreConicConstraints().
+  OsiLorentzConeType const * coneOsiTypes() const { return coneOsiType_; }
+  /// Get sizes of cones. Size of getNumCoreConicConstraints().
+  int const * coneSizes() const { return coneSize_; }
+  /// Get members of cones, coneMemberPtrs()[i] is the array of members of
+  /// cone i.
+  int const * const * coneMemberPtrs() const { return coneMemberPtr_; }
   //@}
 
   ///@name Querry relaxed problem objects
@@ -321,6 +479,21 @@ public:
   int numRelaxedRows() const {return numRelaxedRows_;}
   /// Get array of indices to relaxed rows.
   int const * relaxedRows() const {return relaxedRows_;}
+  /// Get infeasibilities of relaxed rows computed by feasibleSolution() for
+  /// the current solver solution. Returns NULL if the solver is resolved
+  /// after the last feasibleSolution() call.
+  double const * relaxedRowInf() const {
+    return relaxedRowInfValid_ ? relaxedRowInf_ : NULL;
+  }
+  /// Mark relaxed row infeasibilities out of date, called whenever the
+  /// solver rows, column bounds or solution change.
+  void invalidateRelaxedRowInf() { relaxedRowInfValid_ = false; }
+  /// Get relaxed rows violated at sol by more than the cone tolerance, most
+  /// violated first, in rows. At most cutOaMaxCones rows are returned when it
+  /// is positive. Cached infeasibilities are used when they are up to date,
+  /// otherwise they are computed at sol into infeas.
+  void violatedRelaxedRows(double const * sol, std::vector<double> & infeas,
+                           std::vector<int> & rows);
   //@}
 
   ///@name Constraint Generation related.
@@ -337,7 +510,10 @@ public:
   long unsigned int numConGenerators() const { return conGenerators_.size(); }
   /// Get a specific constraint generator.
   DcoConGenerator * conGenerators(DcoConstraintType type) const { return conGenerators_.at(type); }
-  std::map<DcoConstraintType, DcoConGenerator*> conGenerators() { return conGenerators_; }
+  /// Get all constraint generators.
+  std::map<DcoConstraintType, DcoConGenerator*> & conGenerators() {
+    return conGenerators_;
+  }
   /// Get global cut strategy. It will be set using specific cut strategies, to
   /// the most allowing one. If we have strategies with root and periodic
   /// calls, it will be set to periodic.
@@ -348,6 +524,10 @@ public:
   void setCutStrategy(DcoCutStrategy strategy) {cutStrategy_ = strategy;}
   /// greatest common divisor of all cut generation strategies
   int cutGenerationFrequency() const { return cutGenerationFrequency_; }
+  /// Get implication table filled by probing.
+  DcoImplications * implications() { return implications_; }
+  /// Get node bound propagation, NULL if it is disabled.
+  DcoPropagator * propagator() { return propagator_; }
   //@}
 
   ///@name Heuristics related
@@ -358,6 +538,37 @@ public:
   DcoHeuristic const * heuristics(long unsigned int i) const { return heuristics_[i]; }
   // get a specific heuristic, for solution search
   DcoHeuristic * heuristics(long unsigned int i) { return heuristics_[i]; }
+  // get heuristic executor, NULL if heuristics are called synchronously.
+  DcoHeurExecutor * heurExecutor() { return heurExecutor_; }
+  // get local search heuristic, NULL if it is disabled.
+  DcoHeurLocalSearch * localSearch() { return localSearch_; }
+  /// Store sol in the broker, which takes ownership of it, and update the
+  /// solver cutoff. If sol improves the incumbent and the user cutoff it is
+  /// reported and, if improve is true, local search is run on it before it
+  /// is stored. An improved solution is stored the same way. Callers must
+  /// not use sol after this call, source tells what found it.
+  void storeSolution(DcoSolution * sol, std::string const & source,
+                     bool improve = true);
+  /// Run local search on sol. Returns the improved solution, polished if
+  /// Dco_polish is set, or NULL. Caller owns the returned solution.
+  DcoSolution * improveSolution(DcoSolution const * sol);
+  /// Append a JSON line for sol to Dco_incumbentFile. Called for a new
+  /// incumbent before it is stored in the broker, source tells what found
+  /// it.
+  void reportIncumbent(DcoSolution const * sol, std::string const & source);
+  /// Polish sol if Dco_polish is set and sol may improve the incumbent, see
+  /// polishSolution(). Returns the polished solution and frees sol if it is
+  /// accepted, its value replaces the approximate value of sol even if it
+  /// is worse. Returns sol otherwise.
+  DcoSolution * polishCandidate(DcoSolution * sol);
+  /// Polish and store sol found by heuristic heur, see storeSolution().
+  /// The stored solution keeps the depth of sol.
+  void storeHeuristicSolution(DcoHeuristic const * heur, DcoSolution * sol);
+  /// Wait for the heuristic thread and store the solutions it queued since
+  /// the last node drained them. Called when the search ends, before the
+  /// best solution is read. Solutions left in the executor are freed
+  /// unused when it is deleted.
+  void collectHeuristicSolutions();
   //@}
 
 
@@ -365,14 +576,96 @@ public:
   /// columns and rows.
   virtual DcoSolution * feasibleSolution(int & numInfColumns, double & colInf,
                                          int & numInfRows, double & rowInf);
+  /// Polish the given solution. Integer columns are fixed to their values in
+  /// sol and the continuous problem is resolved to Dco_polishConeTol, with
+  /// an OA loop in OA builds and with the conic solver otherwise. Returns
+  /// the polished solution if it is cone feasible to Dco_polishConeTol, even
+  /// if its objective value is worse than the approximate value of sol. If
+  /// sol is that accurate too the better one is kept. Returns NULL if
+  /// polishing fails or sol is kept. Caller owns the returned solution.
+  DcoSolution * polishSolution(DcoSolution const * sol);
+  /// Check feasibility of the given full column solution with respect to
+  /// the original problem. Returns true if it is feasible. colInf is the
+  /// largest integrality or column bound violation, rowInf is the largest
+  /// linear row violation and coneInf is the largest cone violation.
+  bool checkSolution(double const * sol, double & colInf, double & rowInf,
+                     double & coneInf);
+  /// Get values of the original columns from solution sol of the model,
+  /// values are copied as they are if the problem is not presolved.
+  void postsolve(DcoSolution const * sol, std::vector<double> & values) const;
+
+  ///@name MIP start
+  //@{
+  /// Set a known feasible or partial solution, values[i] is the value of
+  /// original column indices[i]. Columns that are not given are completed by
+  /// solving the continuous problem. If called before setupSelf(), the
+  /// start is processed before the root node, otherwise it is processed
+  /// immediately. Returns false and ignores the start if an index is out of
+  /// range or given more than once.
+  bool setMipStart(int size, int const * indices, double const * values);
+  /// Read a MIP start from file and set it with setMipStart(). Every line
+  /// has a column index and a value, '#' starts a comment. Returns false if
+  /// the file can not be read or the start is ignored.
+  bool readMipStart(char const * file);
+  //@}
 
   ///@name Virtual functions from AlpsModel
   //@{
-  /// Read in the problem instance. Currently linear Mps files and Mosek
-  /// style conic mps files.
+  /// Read in the problem instance. Currently linear Mps files, Mosek
+  /// style conic mps files, CBF files and model snapshots.
   virtual void readInstance(char const * dataFile);
   void readInstanceMps(char const * dataFile);
   void readInstanceCbf(char const * dataFile);
+  /// Read a model snapshot written by writeSnapshot(). Model is ready for
+  /// setupSelf(), preprocess() does nothing.
+  void readInstanceSnapshot(char const * dataFile);
+  /// Write the fields set by readInstance() and preprocess(), including
+  /// the approximation cuts, to file in a versioned binary format. Reading
+  /// it back skips parsing and preprocessing. Files should have extension
+  /// snap. Presolved models are written reduced, their columns are the
+  /// presolved columns. Returns false if the file can not be written.
+  bool writeSnapshot(char const * file) const;
+  /// Write the fields set by readInstance() and preprocess() to file in CBF
+  /// format, including the approximation cuts if cuts is true. Rows are
+  /// streamed from the model, no copy of the problem is built. Presolved
+  /// models are written reduced, their columns are the presolved columns.
+  /// Returns false if the file can not be written.
+  bool writeCbf(char const * file, bool cuts = true) const;
+  /// Write the best solution to file, nonzero values as "index value"
+  /// lines after comments with the objective value. The file can be read
+  /// back as a MIP start. Call it after the search, only the serial and the
+  /// master processes write. Returns false if the file is not written.
+  bool writeSolution(char const * file);
+  /// Load problem min/max c^T x + objConstant subject to
+  /// rowLB <= Ax <= rowUB, colLB <= x <= colUB, x_i integer if isInteger[i]
+  /// is nonzero and cones from caller owned arrays. Arrays are copied. A is
+  /// row ordered, row i has entries rowStart[i] to rowStart[i+1]-1 of
+  /// colIndex and value. Cone i has members coneMembers[coneStart[i]] to
+  /// coneMembers[coneStart[i+1]-1], coneType[i] is 1 for Lorentz and 2 for
+  /// rotated Lorentz cones. isInteger can be NULL if all columns are
+  /// continuous, cone arrays can be NULL if numCones is 0 and row arrays can
+  /// be NULL if numRows is 0. Replaces readInstance(), call it on an empty
+  /// model before the search and do not set Alps_instance. Throws if the
+  /// data is not valid.
+  void loadProblem(int numCols, int numRows, CoinBigIndex const * rowStart,
+                   int const * colIndex, double const * value,
+                   double const * colLB, double const * colUB,
+                   double const * objCoef, double const * rowLB,
+                   double const * rowUB, int const * isInteger,
+                   int numCones, int const * coneStart,
+                   int const * coneMembers, int const * coneType,
+                   double objSense = 1.0, double objConstant = 0.0);
+  /// Solve the model in a serial broker without a command line or a
+  /// parameter file. Parameters are the ones set in dcoPar() and AlpsPar()
+  /// before the call, solver should be set with setSolver(). Best solution
+  /// is available through bestSolution() and bestObjValue() after the
+  /// call, it is also written to Dco_solutionFile if that is set. Returns
+  /// the exit status of the search.
+  AlpsExitStatus solve();
+  /// Get best solution found by solve(), empty if there is none.
+  std::vector<double> const & bestSolution() const { return bestSolution_; }
+  /// Get objective value of bestSolution(), objective constant included.
+  double bestObjValue() const { return bestObjValue_; }
   /// Reads in parameters.
   /// This function is called from AlpsKnowledgeBrokerSerial::initializeSearch
   /// It reads and stores the parameters in alpsPar_ inherited from AlpsModel.
@@ -382,8 +675,8 @@ public:
   /// Called from AlpsKnowledgeBrokerSerial::initializeSearch. Called
   /// after readParameters and preprocess.
   virtual bool setupSelf();
-  /// Preprocessing the model. Default does nothing. We do not have any
-  /// preprocessing for now.
+  /// Preprocessing the model. Presolves the problem if Dco_presolve is set
+  /// and reformulates or approximates the cones.
   /// Called from AlpsKnowledgeBrokerSerial::initializeSearch. Called
   /// after readParameters and before setupSelf.
   virtual void preprocess();
@@ -1,6 +1,37 @@
 #include "DcoNodeDesc.hpp"
 #include "DcoMessage.hpp"
 
+#include <map>
+
+/// Merge bounds ind/val into soft bound list, tighter bound is kept for
+/// columns in both. Result is written to arrays allocated with new[].
+static void dcoMergeSoftBound(BcpsFieldListMod<double> const & list,
+                              int num, int const * ind, double const * val,
+                              bool lower, int & numMerged, int *& mergedInd,
+                              double *& mergedVal) {
+  std::map<int, double> bounds;
+  for (int k=0; k<list.numModify; ++k) {
+    bounds[list.posModify[k]] = list.entries[k];
+  }
+  for (int k=0; k<num; ++k) {
+    std::map<int, double>::iterator it = bounds.find(ind[k]);
+    if (it==bounds.end()) {
+      bounds[ind[k]] = val[k];
+    }
+    else if (lower ? val[k]>it->second : val[k]<it->second) {
+      it->second = val[k];
+    }
+  }
+  numMerged = bounds.size();
+  mergedInd = new int[numMerged];
+  mergedVal = new double[numMerged];
+  std::map<int, double>::const_iterator it = bounds.begin();
+  for (int k=0; it!=bounds.end(); ++it, ++k) {
+    mergedInd[k] = it->first;
+    mergedVal[k] = it->second;
+  }
+}
+
 DcoNodeDesc::DcoNodeDesc() {
   // set if as down branch by default
   branchedDir_ = DcoNodeBranchDirectionDown;
@@ -63,6 +94,25 @@ CoinWarmStartBasis * DcoNodeDesc::getBasis() const {
   return basis_;
 }
 
+void DcoNodeDesc::tightenVarSoftBound(int numLower, int const * lowerInd,
+                                      double const * lowerVal, int numUpper,
+                                      int const * upperInd,
+                                      double const * upperVal) {
+  int num_lower;
+  int * lower_ind;
+  double * lower_val;
+  dcoMergeSoftBound(getVars()->lbSoft, numLower, lowerInd, lowerVal, true,
+                    num_lower, lower_ind, lower_val);
+  int num_upper;
+  int * upper_ind;
+  double * upper_val;
+  dcoMergeSoftBound(getVars()->ubSoft, numUpper, upperInd, upperVal, false,
+                    num_upper, upper_ind, upper_val);
+  // this takes ownership of the arrays.
+  assignVarSoftBound(num_lower, lower_ind, lower_val, num_upper, upper_ind,
+                     upper_val);
+}
+
 /// Encode this to an AlpsEncoded object.
 AlpsReturnStatus DcoNodeDesc::encode(AlpsEncoded * encoded) const {
   // return value
@@ -81,6 +81,12 @@ public:
   void setBasis(CoinWarmStartBasis *& ws);
   /** Get warm start basis. */
   CoinWarmStartBasis * getBasis() const;
+  /// Tighten soft bounds of the given columns. Unlike setVarSoftBound() the
+  /// soft bounds stored already are kept, the tighter one is kept for the
+  /// columns in both.
+  void tightenVarSoftBound(int numLower, int const * lowerInd,
+                           double const * lowerVal, int numUpper,
+                           int const * upperInd, double const * upperVal);
 
   ///@name Encode and Decode functions
   //@{
@@ -25,6 +25,24 @@ void DcoParams::createKeywordList() {
   keys_.push_back(make_pair(std::string("Dco_sharePseudocostSearch"),
                             AlpsParameter(AlpsBoolPar,
                                           sharePseudocostSearch)));
+  keys_.push_back(make_pair(std::string("Dco_presolveKeepIntegers"),
+                            AlpsParameter(AlpsBoolPar, presolveKeepIntegers)));
+  keys_.push_back(make_pair(std::string("Dco_presolveTransform"),
+                            AlpsParameter(AlpsBoolPar, presolveTransform)));
+  keys_.push_back(make_pair(std::string("Dco_heurAsync"),
+                            AlpsParameter(AlpsBoolPar, heurAsync)));
+  keys_.push_back(make_pair(std::string("Dco_polish"),
+                            AlpsParameter(AlpsBoolPar, polish)));
+  keys_.push_back(make_pair(std::string("Dco_heurLocalSearch"),
+                            AlpsParameter(AlpsBoolPar, heurLocalSearch)));
+  keys_.push_back(make_pair(std::string("Dco_cutOaNative"),
+                            AlpsParameter(AlpsBoolPar, cutOaNative)));
+  keys_.push_back(make_pair(std::string("Dco_cutOaIncumbent"),
+                            AlpsParameter(AlpsBoolPar, cutOaIncumbent)));
+  keys_.push_back(make_pair(std::string("Dco_propagate"),
+                            AlpsParameter(AlpsBoolPar, propagate)));
+  keys_.push_back(make_pair(std::string("Dco_reducedCostFixing"),
+                            AlpsParameter(AlpsBoolPar, reducedCostFixing)));
   //--------------------------------------------------------
   // BoolArrayPar
   //--------------------------------------------------------
@@ -121,14 +139,14 @@ void DcoParams::createKeywordList() {
   //                           AlpsParameter(AlpsIntPar, conicCutStrategy)));
   // keys_.push_back(make_pair(std::string("Dco_conicCutGenerationFrequency"),
   //                           AlpsParameter(AlpsIntPar, conicCutGenerationFrequency)));
-  // keys_.push_back(make_pair(std::string("Dco_conicCutMirStrategy"),
-  //                           AlpsParameter(AlpsIntPar, conicCutMirStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_conicCutMirStrategy"),
+                            AlpsParameter(AlpsIntPar, conicCutMirStrategy)));
   // keys_.push_back(make_pair(std::string("Dco_conicCutGD1Strategy"),
   //                           AlpsParameter(AlpsIntPar, conicCutGD1Strategy)));
   // keys_.push_back(make_pair(std::string("Dco_conicCutGD2Strategy"),
   //                           AlpsParameter(AlpsIntPar, conicCutGD2Strategy)));
-  // keys_.push_back(make_pair(std::string("Dco_conicCutMirFreq"),
-  //                           AlpsParameter(AlpsIntPar, conicCutMirFreq)));
+  keys_.push_back(make_pair(std::string("Dco_conicCutMirFreq"),
+                            AlpsParameter(AlpsIntPar, conicCutMirFreq)));
   // keys_.push_back(make_pair(std::string("Dco_conicCutGD1Freq"),
   //                           AlpsParameter(AlpsIntPar, conicCutGD1Freq)));
   // keys_.push_back(make_pair(std::string("Dco_conicCutGD2Freq"),
@@ -139,6 +157,28 @@ void DcoParams::createKeywordList() {
                             AlpsParameter(AlpsIntPar, presolveNumPass)));
   keys_.push_back(make_pair(std::string("Dco_approxNumPass"),
                             AlpsParameter(AlpsIntPar, approxNumPass)));
+  keys_.push_back(make_pair(std::string("Dco_heurRoundSweeps"),
+                            AlpsParameter(AlpsIntPar, heurRoundSweeps)));
+  keys_.push_back(make_pair(std::string("Dco_heurAutoMaxFreq"),
+                            AlpsParameter(AlpsIntPar, heurAutoMaxFreq)));
+  keys_.push_back(make_pair(std::string("Dco_polishNumPass"),
+                            AlpsParameter(AlpsIntPar, polishNumPass)));
+  keys_.push_back(make_pair(std::string("Dco_heurLocalSearchPasses"),
+                            AlpsParameter(AlpsIntPar, heurLocalSearchPasses)));
+  keys_.push_back(make_pair(std::string("Dco_cutNumThreads"),
+                            AlpsParameter(AlpsIntPar, cutNumThreads)));
+  keys_.push_back(make_pair(std::string("Dco_cutOaMaxCones"),
+                            AlpsParameter(AlpsIntPar, cutOaMaxCones)));
+  keys_.push_back(make_pair(std::string("Dco_coneReformulation"),
+                            AlpsParameter(AlpsIntPar, coneReformulation)));
+  keys_.push_back(make_pair(std::string("Dco_cutAutoMaxFreq"),
+                            AlpsParameter(AlpsIntPar, cutAutoMaxFreq)));
+  keys_.push_back(make_pair(std::string("Dco_cutTailOffRounds"),
+                            AlpsParameter(AlpsIntPar, cutTailOffRounds)));
+  keys_.push_back(make_pair(std::string("Dco_readNumThreads"),
+                            AlpsParameter(AlpsIntPar, readNumThreads)));
+  keys_.push_back(make_pair(std::string("Dco_propagateNumPass"),
+                            AlpsParameter(AlpsIntPar, propagateNumPass)));
   //--------------------------------------------------------
   // Double Parameters.
   //--------------------------------------------------------
@@ -178,9 +218,25 @@ void DcoParams::createKeywordList() {
                             AlpsParameter(AlpsDoublePar, cutOaSlack2)));
   keys_.push_back(make_pair(std::string("Dco_cutMilpDelta"),
                             AlpsParameter(AlpsDoublePar, cutMilpDelta)));
+  keys_.push_back(make_pair(std::string("Dco_heurAutoTimeShare"),
+                            AlpsParameter(AlpsDoublePar, heurAutoTimeShare)));
+  keys_.push_back(make_pair(std::string("Dco_polishConeTol"),
+                            AlpsParameter(AlpsDoublePar, polishConeTol)));
+  keys_.push_back(make_pair(std::string("Dco_cutAutoTimeShare"),
+                            AlpsParameter(AlpsDoublePar, cutAutoTimeShare)));
 //--------------------------------------------------------
   // String Parameters.
   //--------------------------------------------------------
+  keys_.push_back(make_pair(std::string("Dco_mipStartFile"),
+                            AlpsParameter(AlpsStringPar, mipStartFile)));
+  keys_.push_back(make_pair(std::string("Dco_snapshotFile"),
+                            AlpsParameter(AlpsStringPar, snapshotFile)));
+  keys_.push_back(make_pair(std::string("Dco_cbfFile"),
+                            AlpsParameter(AlpsStringPar, cbfFile)));
+  keys_.push_back(make_pair(std::string("Dco_incumbentFile"),
+                            AlpsParameter(AlpsStringPar, incumbentFile)));
+  keys_.push_back(make_pair(std::string("Dco_solutionFile"),
+                            AlpsParameter(AlpsStringPar, solutionFile)));
 }
 
 //#############################################################################
@@ -198,6 +254,13 @@ void DcoParams::setDefaultEntries() {
   // presolve parameters
   setEntry(presolveKeepIntegers, true);
   setEntry(presolveTransform, true);
+  setEntry(heurAsync, false);
+  setEntry(polish, true);
+  setEntry(heurLocalSearch, true);
+  setEntry(cutOaNative, false);
+  setEntry(cutOaIncumbent, true);
+  setEntry(propagate, true);
+  setEntry(reducedCostFixing, true);
   //-------------------------------------------------------------
   // Int Parameters.
   //-------------------------------------------------------------
@@ -235,6 +298,8 @@ void DcoParams::setDefaultEntries() {
   setEntry(cutIpmFreq, 1);
   setEntry(cutIpmIntFreq, 1);
   setEntry(cutOaFreq, 1);
+  setEntry(conicCutMirStrategy, DcoCutStrategyNotSet);
+  setEntry(conicCutMirFreq, 100);
   setEntry(difference, -1);
   setEntry(heurStrategy, DcoHeurStrategyPeriodic);
   setEntry(heurCallFrequency, 1);
@@ -248,6 +313,17 @@ void DcoParams::setDefaultEntries() {
   setEntry(logLevel, 2);
   setEntry(presolveNumPass, 5);
   setEntry(approxNumPass, 400);
+  setEntry(heurRoundSweeps, 1);
+  setEntry(heurAutoMaxFreq, 1000);
+  setEntry(polishNumPass, 100);
+  setEntry(heurLocalSearchPasses, 10);
+  setEntry(cutNumThreads, 1);
+  setEntry(cutOaMaxCones, 0);
+  setEntry(coneReformulation, 0);
+  setEntry(cutAutoMaxFreq, 1000);
+  setEntry(cutTailOffRounds, 3);
+  setEntry(readNumThreads, 1);
+  setEntry(propagateNumPass, 5);
   //-------------------------------------------------------------
   // Double Parameters
   //-------------------------------------------------------------
@@ -264,8 +340,8 @@ void DcoParams::setDefaultEntries() {
   setEntry(scaleConFactor, 1000.0);
   setEntry(tailOff, 1e-8);
   setEntry(presolveTolerance, 0.0);
-  // approximation factor, used in OA
-  setEntry(approxFactor, 1.0);
+  // accuracy of polyhedral approximation of cones
+  setEntry(approxFactor, 1e-3);
   // threshold for cut activity used in approximateCones()
   setEntry(cutOaSlack1, 0.0001);
   // threshold for cut activity used in bounding loop
@@ -273,7 +349,15 @@ void DcoParams::setDefaultEntries() {
   setEntry(cutOaBeta, 0.001);
   /// MILP cut generation strategy parameters
   setEntry(cutMilpDelta, 0.0001);
+  setEntry(heurAutoTimeShare, 0.1);
+  setEntry(polishConeTol, 1.0e-8);
+  setEntry(cutAutoTimeShare, 0.2);
   //-------------------------------------------------------------
   // String Parameters
   //-------------------------------------------------------------
+  setEntry(mipStartFile, "");
+  setEntry(snapshotFile, "");
+  setEntry(cbfFile, "");
+  setEntry(incumbentFile, "");
+  setEntry(solutionFile, "");
 }
@@ -13,7 +13,7 @@ public:
   enum chrParams {
     /// Generate cuts during rampup. Default: true
     cutRampUp,
-    /// Presolve or not
+    /// Presolve the problem before the root. Default: false
     presolve,
     ///Share constraints Default: false
     shareConstraints,
@@ -23,9 +23,30 @@ public:
     sharePseudocostRampUp,
     /// Share pseudocost during search Default: false
     sharePseudocostSearch,
-    /// presolve boolean parameters
+    /// Do not remove integer columns in presolve. Default: true
     presolveKeepIntegers,
+    /// Remove singleton columns and tighten coefficients in presolve, these
+    /// change the rows. Default: true
     presolveTransform,
+    /// Run heuristics on a background thread. Default: false
+    heurAsync,
+    /// Improve every new incumbent with local search. Default: true
+    heurLocalSearch,
+    /// Polish new incumbents, fix integers and resolve the continuous problem.
+    /// Default: true
+    polish,
+    /// Separate OA cuts with the in-tree kernel, CglConicOA is used otherwise.
+    /// Default: false
+    cutOaNative,
+    /// Linearize violated cones at the incumbent too when separating OA cuts
+    /// with the in-tree kernel. Default: true
+    cutOaIncumbent,
+    /// Propagate bounds of the nodes over the linear rows and cones before
+    /// solving them. Default: true
+    propagate,
+    /// Tighten column bounds with reduced costs and the incumbent value after
+    /// the subproblems are solved, OA only. Default: true
+    reducedCostFixing,
     //
     endOfChrParams
   };
@@ -49,6 +70,14 @@ public:
     cutStrategy, /** All constraint generators */
     cutGenerationFrequency,
     cutDisable,   /** if no cuts calls is greater than this, disable cg */
+    /// Number of threads used for cut generation, generators run in parallel on
+    /// solver clones when it is larger than 1. Default: 1
+    cutNumThreads,
+    /// Number of threads used for parsing large coordinate blocks of CBF
+    /// files. Default: 1
+    readNumThreads,
+    /// Largest call frequency adaptive cut generator scheduling can set.
+    cutAutoMaxFreq,
     cutCliqueStrategy,
     cutGomoryStrategy,
     cutFlowCoverStrategy,
@@ -64,7 +93,12 @@ public:
     cutOaAlpha,
     cutOaGamma,
     cutOaSlackLimit,
+    /// Largest number of cones passed to OA separator in a round, most violated
+    /// cones are passed first. 0 means no limit.
+    cutOaMaxCones,
     cutMilpGamma,
+    /// Number of last cut rounds the cut loop tailing-off control looks at.
+    cutTailOffRounds,
     ///
 
 
@@ -91,6 +125,14 @@ public:
     heurCallFrequency,
     heurRoundStrategy,
     heurRoundFreq,
+    /// Number of improvement sweeps of rounding heuristic, it is the initial
+    /// work limit of the heuristic.
+    heurRoundSweeps,
+    /// Number of passes of local search over integer columns, it is the work
+    /// limit of the heuristic.
+    heurLocalSearchPasses,
+    /// Largest call frequency adaptive heuristic scheduling can set.
+    heurAutoMaxFreq,
     /** The look ahead of pseudocost. */
     lookAhead,
     /** The reliability of pseudocost. */
@@ -110,17 +152,30 @@ public:
     */
     // conicCutStrategy, /** All constraint generators */
     // conicCutGenerationFrequency,
-    // conicCutMirStrategy,
+    conicCutMirStrategy,
     // conicCutGD1Strategy,
     // conicCutGD2Strategy,
-    // conicCutMirFreq,
+    conicCutMirFreq,
     // conicCutGD1Freq,
     // conicCutGD2Freq,
     logLevel,
-    // presolve parameters
+    /// Largest number of presolve passes. Default: 5
     presolveNumPass,
     // approximation passes, used in OA, overwrites approxFactor
     approxNumPass,
+    /// Reformulation of cones applied by preprocess().
+    ///   0: none,
+    ///   1: extended formulation, cones are disaggregated into rotated cones of
+    ///      size 3,
+    ///   2: Ben-Tal--Nemirovski polyhedral approximation is added to the
+    ///      linear rows, its accuracy is approxFactor.
+    /// Default: 0
+    coneReformulation,
+    /// Maximum number of OA passes used to polish a solution.
+    polishNumPass,
+    /// Largest number of row and cone visits per node in bound propagation,
+    /// as a multiple of the number of rows and cones. Default: 5
+    propagateNumPass,
     ///
     endOfIntParams
   };
@@ -155,24 +210,56 @@ public:
     scaleConFactor,
     /** Tail off */
     tailOff,
-    /// presolve parameters
+    /// Columns with bounds closer than this are fixed and rows violated
+    /// less than this at their worst are redundant in presolve. Default: 0.0
     presolveTolerance,
-    // approximation factor, used in OA
+    /// Accuracy of the polyhedral approximation of cones when
+    /// coneReformulation is 2, points of the approximation of x_1 >= ||x_2n||
+    /// satisfy ||x_2n|| <= (1+approxFactor)x_1. Default: 1e-3
     approxFactor,
-    /// OA cut generation strategy parameters
+    /// OA cut generation strategy parameters. OA cut loop tails off when the
+    /// last cut rounds close less than cutOaBeta of the gap per round.
     cutOaBeta,
     // threshold for cut activity used in approximateCones()
     cutOaSlack1,
     // threshold for cut activity used in bounding loop
     cutOaSlack2,
-    /// MILP cut tailoff, keep generating as long as imprvement is larger than
-    /// delta
+    /// MILP cut tailoff, keep generating as long as the last cut round
+    /// improves the bound by more than delta times the objective value and
+    /// the last cut rounds improve it faster than branching.
     cutMilpDelta,
+    /// Share of node processing time adaptive cut generator scheduling allows
+    /// a generator that improves the bound at half of its calls to use.
+    cutAutoTimeShare,
+    /// Share of node processing time adaptive heuristic scheduling allows a
+    /// heuristic with 50% success rate to use.
+    heurAutoTimeShare,
+    /// Cone tolerance used to polish a solution.
+    polishConeTol,
     endOfDblParams
   };
   /** String parameters. */
   enum strParams{
     strDummy,
+    /// File with a known feasible or partial solution, read before the root
+    /// is processed. Lines are "index value" pairs, '#' starts a comment.
+    mipStartFile,
+    /// File the model is written to after preprocessing, in the binary
+    /// snapshot format. Give the file, with extension snap, as the instance
+    /// of later runs to skip reading and preprocessing. Empty to not write.
+    /// Presolved models are written reduced.
+    snapshotFile,
+    /// File the model is written to after preprocessing, in CBF format,
+    /// approximation cuts included. Empty to not write. Presolved models are
+    /// written reduced.
+    cbfFile,
+    /// File every new incumbent is appended to as a JSON line with time,
+    /// objective, gap, node count and nonzero values. Empty to not write.
+    incumbentFile,
+    /// File the best solution is written to at the end, as "index value"
+    /// lines of nonzero values. Solution is not printed to the log if it is
+    /// set. Empty to not write.
+    solutionFile,
     //
     endOfStrParams
   };
@@ -1,78 +1,618 @@
 #include "DcoPresolve.hpp"
-#include "DcoModel.hpp"
-#include "DcoConicConstraint.hpp"
-
-bool DcoPresolve::improve_bounds(DcoModel * model) {
-  bool updated = false;
-  // iterate over cones and improve bounds
-  int num_linear = model->getNumCoreLinearConstraints();
-  int num_cones = model->getNumCoreConicConstraints();
-
-  // get bounds, these will get updated through the process.
-  double * collb = model->colLB();
-  double * colub = model->colUB();
-
-  for (int i=num_linear; i<num_linear+num_cones; ++i) {
-    // get constraint
-    DcoConicConstraint * curr =
-      dynamic_cast<DcoConicConstraint*>(model->getConstraints()[i]);
-    // get type
-    DcoLorentzConeType type = curr->coneType();
-    if (type==DcoLorentzCone) {
-      int lead_index = curr->coneMembers()[0];
-      double lead_bound = colub[lead_index];
-      // set lower and upper bounds of the other cone members
-      for (int j=1; j<curr->coneSize(); j++) {
-        // if lower bound is less than -lead_bound, update it
-        if (collb[j]<-lead_bound) {
-          // debug stuff
-          std::stringstream debug_msg;
-          debug_msg << "Lower bound of col ";
-          debug_msg << j;
-          debug_msg << " is updated from ";
-          debug_msg << collb[j];
-          debug_msg << " to ";
-          debug_msg << -lead_bound;
-          model->dcoMessageHandler_->message(0, "Dco", debug_msg.str().c_str(),
-                                             'G', DISCO_DLOG_PRESOLVE)
-            << CoinMessageEol;
-          // end of debug stuff
-          // do the update
-          collb[j] = -lead_bound;
-          updated = true;
-        }
-        // if upper bound is larger than lead_bound, update it
-        if (colub[j]>lead_bound) {
-          // debug stuff
-          std::stringstream debug_msg;
-          debug_msg << "Upper bound of col ";
-          debug_msg << j;
-          debug_msg << " is updated from ";
-          debug_msg << colub[j];
-          debug_msg << " to ";
-          debug_msg << lead_bound;
-          model->dcoMessageHandler_->message(0, "Dco", debug_msg.str().c_str(),
-                                             'G', DISCO_DLOG_PRESOLVE)
-            << CoinMessageEol;
-          // end of debug stuff
-          // do the update
-          colub[j] = lead_bound;
-          updated = true;
-        }
+
+#include <CoinPackedMatrix.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+/// Bounds larger than this in absolute value are infinite.
+static double const dcoPresolveInfinity = 1e20;
+/// Implied bounds larger than this in absolute value are not used.
+static double const dcoPresolveMaxBound = 1e8;
+/// Bounds are changed only if they improve more than this, relative to the
+/// magnitude of the bound.
+static double const dcoPresolveMinChange = 1e-6;
+/// Bounds crossing less than this, relative to their magnitude, are
+/// considered equal.
+static double const dcoPresolveFeasTol = 1e-6;
+/// Coefficients are tightened if they change more than this.
+static double const dcoPresolveCoefTol = 1e-6;
+
+DcoPresolve::DcoPresolve(int numCols, int numRows,
+                         CoinPackedMatrix const * matrix,
+                         double const * colLB, double const * colUB,
+                         double const * objCoef, int const * isInteger,
+                         double const * rowLB, double const * rowUB,
+                         int numCones, int const * coneStart,
+                         int const * coneMembers, int const * coneType):
+  DcoBoundTightener(numCols, isInteger),
+  numCols_(numCols), numRows_(numRows), numCones_(numCones),
+  colLB_(colLB, colLB+numCols), colUB_(colUB, colUB+numCols),
+  objCoef_(objCoef, objCoef+numCols), rowInd_(numRows), rowVal_(numRows),
+  rowLB_(rowLB, rowLB+numRows),
+  rowUB_(rowUB, rowUB+numRows), colRows_(numCols), colNumCones_(numCols, 0),
+  coneMembers_(numCones), coneType_(coneType, coneType+numCones),
+  colRemoved_(numCols, false), rowRemoved_(numRows, false),
+  coneRemoved_(numCones, false), objOffset_(0.0), numPasses_(0),
+  numCoefChanged_(0) {
+  if (numCols_) {
+    lb_ = &colLB_[0];
+    ub_ = &colUB_[0];
+  }
+  minChange_ = dcoPresolveMinChange;
+  CoinPackedMatrix row_matrix;
+  if (matrix->isColOrdered()) {
+    row_matrix.reverseOrderedCopyOf(*matrix);
+    matrix = &row_matrix;
+  }
+  for (int i=0; i<numRows_; ++i) {
+    CoinShallowPackedVector row = matrix->getVector(i);
+    for (int k=0; k<row.getNumElements(); ++k) {
+      if (row.getElements()[k]!=0.0) {
+        rowInd_[i].push_back(row.getIndices()[k]);
+        rowVal_[i].push_back(row.getElements()[k]);
+        colRows_[row.getIndices()[k]].push_back(i);
+      }
+    }
+  }
+  for (int i=0; i<numCones_; ++i) {
+    coneMembers_[i].assign(coneMembers+coneStart[i],
+                           coneMembers+coneStart[i+1]);
+    for (int k=coneStart[i]; k<coneStart[i+1]; ++k) {
+      colNumCones_[coneMembers[k]]++;
+    }
+  }
+  // every column is kept until presolve() is called.
+  for (int i=0; i<numCols_; ++i) {
+    colMap_.push_back(i);
+    reducedIndex_.push_back(i);
+  }
+}
+
+DcoPresolve::~DcoPresolve() {
+}
+
+void DcoPresolve::rowActivity(int row, double & minAct, int & minInf,
+                              double & maxAct, int & maxInf) const {
+  if (rowInd_[row].empty()) {
+    activity(0, NULL, NULL, minAct, minInf, maxAct, maxInf);
+    return;
+  }
+  activity(rowInd_[row].size(), &rowInd_[row][0], &rowVal_[row][0], minAct,
+           minInf, maxAct, maxInf);
+}
+
+double DcoPresolve::removeEntry(int row, int col) {
+  std::vector<int> & ind = rowInd_[row];
+  int pos = std::find(ind.begin(), ind.end(), col) - ind.begin();
+  double value = rowVal_[row][pos];
+  ind.erase(ind.begin()+pos);
+  rowVal_[row].erase(rowVal_[row].begin()+pos);
+  std::vector<int> & rows = colRows_[col];
+  rows.erase(std::find(rows.begin(), rows.end(), row));
+  return value;
+}
+
+void DcoPresolve::removeRow(int row) {
+  for (unsigned int k=0; k<rowInd_[row].size(); ++k) {
+    std::vector<int> & rows = colRows_[rowInd_[row][k]];
+    rows.erase(std::find(rows.begin(), rows.end(), row));
+  }
+  rowInd_[row].clear();
+  rowVal_[row].clear();
+  rowRemoved_[row] = true;
+}
+
+void DcoPresolve::removeCone(int cone) {
+  for (unsigned int k=0; k<coneMembers_[cone].size(); ++k) {
+    colNumCones_[coneMembers_[cone][k]]--;
+  }
+  coneMembers_[cone].clear();
+  coneRemoved_[cone] = true;
+}
+
+int DcoPresolve::presolveRowSingletons() {
+  int changes = 0;
+  for (int i=0; i<numRows_ and !infeasible_; ++i) {
+    if (rowRemoved_[i] or rowInd_[i].size()>1) {
+      continue;
+    }
+    double lb = rowLB_[i];
+    double ub = rowUB_[i];
+    if (rowInd_[i].empty()) {
+      if (lb>tol_+dcoPresolveFeasTol or ub<-tol_-dcoPresolveFeasTol) {
+        infeasible_ = true;
+        break;
+      }
+      removeRow(i);
+      changes++;
+      continue;
+    }
+    // lb <= a x <= ub, bounds of x
+    int col = rowInd_[i][0];
+    double a = rowVal_[i][0];
+    double low = -COIN_DBL_MAX;
+    double high = COIN_DBL_MAX;
+    if (lb>-dcoPresolveInfinity) {
+      (a>0.0 ? low : high) = lb/a;
+    }
+    if (ub<dcoPresolveInfinity) {
+      (a>0.0 ? high : low) = ub/a;
+    }
+    // the row is kept if its bounds are too large to be column bounds.
+    if ((low>-dcoPresolveInfinity and fabs(low)>dcoPresolveMaxBound) or
+        (high<dcoPresolveInfinity and fabs(high)>dcoPresolveMaxBound)) {
+      continue;
+    }
+    if (low>-dcoPresolveInfinity) {
+      tightenLower(col, low);
+    }
+    if (high<dcoPresolveInfinity) {
+      tightenUpper(col, high);
+    }
+    removeRow(i);
+    changes++;
+  }
+  return changes;
+}
+
+int DcoPresolve::tightenRowBounds() {
+  int changes = 0;
+  for (int i=0; i<numRows_ and !infeasible_; ++i) {
+    if (rowRemoved_[i]) {
+      continue;
+    }
+    double lb = rowLB_[i];
+    double ub = rowUB_[i];
+    bool has_lb = lb>-dcoPresolveInfinity;
+    bool has_ub = ub<dcoPresolveInfinity;
+    double min_act, max_act;
+    int min_inf, max_inf;
+    rowActivity(i, min_act, min_inf, max_act, max_inf);
+    double scale = std::max(has_lb ? fabs(lb) : 0.0, has_ub ? fabs(ub) : 0.0);
+    double feas_tol = tol_ + dcoPresolveFeasTol*std::max(1.0, scale);
+    if ((has_ub and min_inf==0 and min_act>ub+feas_tol) or
+        (has_lb and max_inf==0 and max_act<lb-feas_tol)) {
+      infeasible_ = true;
+      break;
+    }
+    for (unsigned int k=0; k<rowInd_[i].size() and !infeasible_; ++k) {
+      int col = rowInd_[i][k];
+      double a = rowVal_[i][k];
+      double low = a>0.0 ? colLB_[col] : colUB_[col];
+      double high = a>0.0 ? colUB_[col] : colLB_[col];
+      bool low_inf = fabs(low)>=dcoPresolveInfinity;
+      bool high_inf = fabs(high)>=dcoPresolveInfinity;
+      // activity of the other entries
+      int rest_min_inf = min_inf - (low_inf ? 1 : 0);
+      int rest_max_inf = max_inf - (high_inf ? 1 : 0);
+      double rest_min = min_act - (low_inf ? 0.0 : a*low);
+      double rest_max = max_act - (high_inf ? 0.0 : a*high);
+      bool changed = false;
+      // a x <= ub - rest_min
+      if (has_ub and rest_min_inf==0) {
+        double bound = (ub-rest_min)/a;
+        changed |= a>0.0 ? tightenUpper(col, bound) : tightenLower(col, bound);
+      }
+      // a x >= lb - rest_max
+      if (has_lb and rest_max_inf==0) {
+        double bound = (lb-rest_max)/a;
+        changed |= a>0.0 ? tightenLower(col, bound) : tightenUpper(col, bound);
+      }
+      if (changed) {
+        changes++;
+        // only the contribution of col changes, add its new bounds to the
+        // activity of the other entries.
+        low = a>0.0 ? colLB_[col] : colUB_[col];
+        high = a>0.0 ? colUB_[col] : colLB_[col];
+        low_inf = fabs(low)>=dcoPresolveInfinity;
+        high_inf = fabs(high)>=dcoPresolveInfinity;
+        min_act = rest_min + (low_inf ? 0.0 : a*low);
+        max_act = rest_max + (high_inf ? 0.0 : a*high);
+        min_inf = rest_min_inf + (low_inf ? 1 : 0);
+        max_inf = rest_max_inf + (high_inf ? 1 : 0);
+      }
+    }
+  }
+  return changes;
+}
+
+int DcoPresolve::tightenConeBounds() {
+  int changes = 0;
+  for (int i=0; i<numCones_ and !infeasible_; ++i) {
+    if (coneRemoved_[i]) {
+      continue;
+    }
+    changes += tightenCone(coneMembers_[i].size(), &coneMembers_[i][0],
+                           coneType_[i]);
+  }
+  return changes;
+}
+
+int DcoPresolve::removeRedundantRows() {
+  int changes = 0;
+  for (int i=0; i<numRows_; ++i) {
+    if (rowRemoved_[i]) {
+      continue;
+    }
+    double min_act, max_act;
+    int min_inf, max_inf;
+    rowActivity(i, min_act, min_inf, max_act, max_inf);
+    bool lb_redundant = rowLB_[i]<=-dcoPresolveInfinity or
+      (min_inf==0 and min_act>=rowLB_[i]-tol_);
+    bool ub_redundant = rowUB_[i]>=dcoPresolveInfinity or
+      (max_inf==0 and max_act<=rowUB_[i]+tol_);
+    if (lb_redundant and ub_redundant) {
+      removeRow(i);
+      changes++;
+    }
+  }
+  return changes;
+}
+
+int DcoPresolve::presolveCones() {
+  int changes = 0;
+  for (int i=0; i<numCones_ and !infeasible_; ++i) {
+    if (coneRemoved_[i]) {
+      continue;
+    }
+    std::vector<int> & members = coneMembers_[i];
+    int first = coneType_[i];
+    // leading members are nonnegative, a zero leading member forces the
+    // other members to 0.
+    bool zero_lead = false;
+    for (int k=0; k<first; ++k) {
+      tightenLower(members[k], 0.0);
+      zero_lead = zero_lead or colUB_[members[k]]<=tol_;
+    }
+    if (zero_lead) {
+      for (unsigned int k=first; k<members.size(); ++k) {
+        tightenLower(members[k], 0.0);
+        tightenUpper(members[k], 0.0);
+      }
+      removeCone(i);
+      changes++;
+      continue;
+    }
+    // members fixed to 0 do not contribute
+    for (unsigned int k=first; k<members.size(); ) {
+      int col = members[k];
+      if (colLB_[col]>=-tol_ and colUB_[col]<=tol_) {
+        members.erase(members.begin()+k);
+        colNumCones_[col]--;
+        changes++;
+      }
+      else {
+        ++k;
+      }
+    }
+    if (members.size()==(unsigned int)first) {
+      removeCone(i);
+      changes++;
+      continue;
+    }
+    // cone is satisfied by the bounds if the smallest value of the leading
+    // side is larger than the largest value of the other side.
+    double max2 = 0.0;
+    bool bounded = true;
+    for (unsigned int k=first; k<members.size() and bounded; ++k) {
+      double lb = colLB_[members[k]];
+      double ub = colUB_[members[k]];
+      bounded = lb>-dcoPresolveInfinity and ub<dcoPresolveInfinity;
+      double m = std::max(fabs(lb), fabs(ub));
+      max2 += m*m;
+    }
+    double lead_min = colLB_[members[0]]*colLB_[members[0]];
+    if (first==2) {
+      lead_min = 2.0*colLB_[members[0]]*colLB_[members[1]];
+    }
+    if (bounded and lead_min>=max2) {
+      removeCone(i);
+      changes++;
+    }
+  }
+  return changes;
+}
+
+int DcoPresolve::removeFixedCols(bool keepIntegers) {
+  int changes = 0;
+  for (int i=0; i<numCols_; ++i) {
+    if (colRemoved_[i] or colNumCones_[i] or
+        (keepIntegers and isInteger_[i])) {
+      continue;
+    }
+    double lb = colLB_[i];
+    double ub = colUB_[i];
+    if (lb<=-dcoPresolveInfinity or ub>=dcoPresolveInfinity or
+        ub-lb>tol_) {
+      continue;
+    }
+    double value = isInteger_[i] ? floor(lb+0.5) : lb;
+    // move a x to the row bounds
+    while (!colRows_[i].empty()) {
+      int row = colRows_[i].back();
+      double a = removeEntry(row, i);
+      if (rowLB_[row]>-dcoPresolveInfinity) {
+        rowLB_[row] -= a*value;
       }
+      if (rowUB_[row]<dcoPresolveInfinity) {
+        rowUB_[row] -= a*value;
+      }
+    }
+    objOffset_ += objCoef_[i]*value;
+    DcoPostsolveStep step;
+    step.col = i;
+    step.value = value;
+    step.singleton = false;
+    steps_.push_back(step);
+    colRemoved_[i] = true;
+    changes++;
+  }
+  return changes;
+}
+
+int DcoPresolve::removeSingletonCols() {
+  int changes = 0;
+  for (int i=0; i<numCols_; ++i) {
+    if (colRemoved_[i] or colNumCones_[i] or isInteger_[i] or
+        objCoef_[i]!=0.0 or colRows_[i].size()!=1) {
+      continue;
+    }
+    int row = colRows_[i][0];
+    if (rowInd_[row].size()<2) {
+      continue;
+    }
+    double a = removeEntry(row, i);
+    DcoPostsolveStep step;
+    step.col = i;
+    step.value = 0.0;
+    step.singleton = true;
+    step.coef = a;
+    step.lb = colLB_[i];
+    step.ub = colUB_[i];
+    step.rowLB = rowLB_[row];
+    step.rowUB = rowUB_[row];
+    step.start = stepInd_.size();
+    stepInd_.insert(stepInd_.end(), rowInd_[row].begin(), rowInd_[row].end());
+    stepVal_.insert(stepVal_.end(), rowVal_[row].begin(), rowVal_[row].end());
+    step.end = stepInd_.size();
+    steps_.push_back(step);
+    // rest of the row is in [rowLB - max a x, rowUB - min a x]
+    double low = a>0.0 ? colLB_[i] : colUB_[i];
+    double high = a>0.0 ? colUB_[i] : colLB_[i];
+    if (rowLB_[row]>-dcoPresolveInfinity and
+        fabs(high)<dcoPresolveInfinity) {
+      rowLB_[row] -= a*high;
+    }
+    else {
+      rowLB_[row] = -COIN_DBL_MAX;
     }
-    else if (type==DcoRotatedLorentzCone) {
-      model->dcoMessageHandler_->message(0, "Dco",
-                                         "Presolve is not implemented for "
-                                         "rotated cones yet, skipping...",
-                                         'G', DISCO_DLOG_PRESOLVE)
-        << CoinMessageEol;
+    if (rowUB_[row]<dcoPresolveInfinity and
+        fabs(low)<dcoPresolveInfinity) {
+      rowUB_[row] -= a*low;
     }
     else {
-      model->dcoMessageHandler_->message(DISCO_UNKNOWN_CONETYPE,
-                                         *model->dcoMessages_)
-        << type << CoinMessageEol;
+      rowUB_[row] = COIN_DBL_MAX;
+    }
+    colRemoved_[i] = true;
+    changes++;
+  }
+  return changes;
+}
+
+int DcoPresolve::tightenCoefficients() {
+  int changes = 0;
+  for (int i=0; i<numRows_; ++i) {
+    if (rowRemoved_[i]) {
+      continue;
+    }
+    bool has_lb = rowLB_[i]>-dcoPresolveInfinity;
+    bool has_ub = rowUB_[i]<dcoPresolveInfinity;
+    if (has_lb==has_ub) {
+      continue;
+    }
+    // write the row as s a^T x <= rhs
+    double sign = has_ub ? 1.0 : -1.0;
+    double rhs = has_ub ? rowUB_[i] : -rowLB_[i];
+    double min_act, max_act;
+    int min_inf, max_inf;
+    rowActivity(i, min_act, min_inf, max_act, max_inf);
+    if ((has_ub ? max_inf : min_inf)>0) {
+      continue;
+    }
+    max_act = has_ub ? max_act : -min_act;
+    if (max_act<=rhs+tol_) {
+      continue;
+    }
+    bool changed = false;
+    for (unsigned int k=0; k<rowInd_[i].size(); ++k) {
+      int col = rowInd_[i][k];
+      if (!isInteger_[col] or colLB_[col]!=0.0 or colUB_[col]!=1.0) {
+        continue;
+      }
+      double a = sign*rowVal_[i][k];
+      if (a>0.0 and max_act-a<rhs-dcoPresolveCoefTol) {
+        // row is redundant when x is 0, a-d x + rest <= rhs-d is the same
+        // row for x 1.
+        double d = rhs - (max_act-a);
+        max_act -= d;
+        rhs -= d;
+        a -= d;
+      }
+      else if (a<0.0 and max_act+a<rhs-dcoPresolveCoefTol) {
+        // row is redundant when x is 1.
+        a = rhs - max_act;
+      }
+      else {
+        continue;
+      }
+      rowVal_[i][k] = sign*a;
+      numCoefChanged_++;
+      changes++;
+      changed = true;
+    }
+    if (changed) {
+      (has_ub ? rowUB_[i] : rowLB_[i]) = sign*rhs;
+    }
+  }
+  return changes;
+}
+
+bool DcoPresolve::presolve(int numPass, double tol, bool keepIntegers,
+                           bool transform) {
+  tol_ = tol;
+  while (numPasses_<numPass and !infeasible_) {
+    numPasses_++;
+    int changes = presolveRowSingletons();
+    changes += tightenRowBounds();
+    changes += tightenConeBounds();
+    changes += removeRedundantRows();
+    changes += presolveCones();
+    changes += removeFixedCols(keepIntegers);
+    if (transform) {
+      changes += removeSingletonCols();
+      changes += tightenCoefficients();
+    }
+    if (changes==0) {
+      break;
+    }
+  }
+  if (infeasible_) {
+    return false;
+  }
+  colMap_.clear();
+  for (int i=0; i<numCols_; ++i) {
+    reducedIndex_[i] = -1;
+    if (!colRemoved_[i]) {
+      reducedIndex_[i] = colMap_.size();
+      colMap_.push_back(i);
+    }
+  }
+  return true;
+}
+
+void DcoPresolve::getProblem(int & numCols, int & numRows, double *& colLB,
+                             double *& colUB, double *& objCoef,
+                             int *& isInteger, int & numInteger,
+                             int *& integerCols, double *& rowLB,
+                             double *& rowUB, CoinPackedMatrix *& matrix,
+                             int & numCones, int *& coneStart,
+                             int *& coneMembers, int *& coneType) const {
+  numCols = colMap_.size();
+  colLB = new double[numCols];
+  colUB = new double[numCols];
+  objCoef = new double[numCols];
+  isInteger = new int[numCols];
+  numInteger = 0;
+  for (int i=0; i<numCols; ++i) {
+    int col = colMap_[i];
+    colLB[i] = colLB_[col];
+    colUB[i] = colUB_[col];
+    objCoef[i] = objCoef_[col];
+    isInteger[i] = isInteger_[col];
+    numInteger += isInteger[i] ? 1 : 0;
+  }
+  integerCols = new int[numInteger];
+  for (int i=0, k=0; i<numCols; ++i) {
+    if (isInteger[i]) {
+      integerCols[k++] = i;
+    }
+  }
+  // rows in CSR form
+  std::vector<int> rows;
+  std::vector<CoinBigIndex> start(1, 0);
+  std::vector<int> length;
+  std::vector<int> ind;
+  std::vector<double> val;
+  for (int i=0; i<numRows_; ++i) {
+    if (rowRemoved_[i]) {
+      continue;
+    }
+    rows.push_back(i);
+    for (unsigned int k=0; k<rowInd_[i].size(); ++k) {
+      ind.push_back(reducedIndex_[rowInd_[i][k]]);
+      val.push_back(rowVal_[i][k]);
+    }
+    start.push_back(ind.size());
+    length.push_back(rowInd_[i].size());
+  }
+  numRows = rows.size();
+  // cones
+  std::vector<int> cones;
+  for (int i=0; i<numCones_; ++i) {
+    if (!coneRemoved_[i]) {
+      cones.push_back(i);
     }
   }
-  return updated;
+  numCones = cones.size();
+  rowLB = new double[numRows+numCones];
+  rowUB = new double[numRows+numCones];
+  for (int i=0; i<numRows; ++i) {
+    rowLB[i] = rowLB_[rows[i]];
+    rowUB[i] = rowUB_[rows[i]];
+  }
+  std::fill_n(rowLB+numRows, numCones, 0.0);
+  std::fill_n(rowUB+numRows, numCones, COIN_DBL_MAX);
+  matrix = new CoinPackedMatrix(false, numCols, numRows, ind.size(),
+                                val.empty() ? NULL : &val[0],
+                                ind.empty() ? NULL : &ind[0], &start[0],
+                                length.empty() ? NULL : &length[0]);
+  coneStart = new int[numCones+1];
+  coneType = new int[numCones];
+  coneStart[0] = 0;
+  for (int i=0; i<numCones; ++i) {
+    coneStart[i+1] = coneStart[i] + coneMembers_[cones[i]].size();
+    coneType[i] = coneType_[cones[i]];
+  }
+  coneMembers = new int[coneStart[numCones]];
+  for (int i=0; i<numCones; ++i) {
+    std::vector<int> const & members = coneMembers_[cones[i]];
+    for (unsigned int k=0; k<members.size(); ++k) {
+      coneMembers[coneStart[i]+k] = reducedIndex_[members[k]];
+    }
+  }
+}
+
+void DcoPresolve::postsolve(double const * values,
+                            double * origValues) const {
+  std::fill_n(origValues, numCols_, 0.0);
+  for (unsigned int i=0; i<colMap_.size(); ++i) {
+    origValues[colMap_[i]] = values[i];
+  }
+  // columns are restored in the reverse order of removal, columns in the
+  // row of a singleton are known by then.
+  for (int i=steps_.size()-1; i>=0; --i) {
+    DcoPostsolveStep const & step = steps_[i];
+    if (!step.singleton) {
+      origValues[step.col] = step.value;
+      continue;
+    }
+    double rest = 0.0;
+    for (int k=step.start; k<step.end; ++k) {
+      rest += stepVal_[k]*origValues[stepInd_[k]];
+    }
+    // a x should be in [rowLB - rest, rowUB - rest], take the value closest
+    // to 0 within the column bounds.
+    double a = step.coef;
+    double low = -COIN_DBL_MAX;
+    double high = COIN_DBL_MAX;
+    if (step.rowLB>-dcoPresolveInfinity) {
+      (a>0.0 ? low : high) = (step.rowLB-rest)/a;
+    }
+    if (step.rowUB<dcoPresolveInfinity) {
+      (a>0.0 ? high : low) = (step.rowUB-rest)/a;
+    }
+    low = std::max(low, step.lb);
+    high = std::min(high, step.ub);
+    double value = std::min(std::max(0.0, low), high);
+    origValues[step.col] = std::min(std::max(value, step.lb), step.ub);
+  }
+}
+
+int DcoPresolve::numRemovedRows() const {
+  return std::count(rowRemoved_.begin(), rowRemoved_.end(), true);
+}
+
+int DcoPresolve::numRemovedCones() const {
+  return std::count(coneRemoved_.begin(), coneRemoved_.end(), true);
 }
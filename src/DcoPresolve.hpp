@@ -1,67 +1,192 @@
 #ifndef DcoPresolve_hpp_
 #define DcoPresolve_hpp_
 
-#include "OsiPresolve.hpp"
+#include "DcoBoundTightener.hpp"
 
-#if defined(__OA__)
-  #include <OsiClpSolverInterface.hpp>
-#else
-  #include <OsiConicSolverInterface.hpp>
-#endif
+#include <vector>
 
+class CoinPackedMatrix;
 
-class DcoModel;
+/// Column removed by presolve, restored by DcoPresolve::postsolve() in the
+/// reverse order of removal.
+struct DcoPostsolveStep {
+  /// Original index of the column.
+  int col;
+  /// Value of a fixed column. Not used for singleton columns.
+  double value;
+  ///@name Singleton columns
+  /// Column appeared only in row rowLB <= coef x_col + a^T x <= rowUB with
+  /// bounds lb <= x_col <= ub. Entries of a are in
+  /// DcoPresolve::stepInd_/stepVal_ from start to end.
+  //@{
+  bool singleton;
+  double coef;
+  double lb;
+  double ub;
+  double rowLB;
+  double rowUB;
+  int start;
+  int end;
+  //@}
+};
 
 /*!
-  This class is for pre-processing of the conic problems. It is built
-  on top of OsiPresolve class which has pre-procesiing methods for linear
-  problems.
+  DcoPresolve reduces mixed integer second order cone problems given in the
+  form of DcoModel fields, rowLB <= Ax <= rowUB, colLB <= x <= colUB and
+  cones. Columns are referred with their original indices until the reduced
+  problem is extracted with getProblem(). Every pass of presolve() does
 
-  This class accomodates the two cases when the underlying solver interface is
-  a linear (OsiSolverInterface) or conic one (OsiConicSolverInterface).
+  <ul>
+  <li> Row singletons are turned into column bounds, empty rows are dropped.
+  <li> Linear bound tightening, column bounds implied by row activities.
+  <li> Conic bound tightening. For x_1 >= ||x_2n|| members are bounded by
+       x_1 and x_1 is bounded below by the distance of the member box to
+       the origin, 2x_1x_2 >= ||x_3n||^2 is treated the same way.
+  <li> Redundant rows, rows satisfied by every point in the bounds, are
+       dropped.
+  <li> Cone member fixing. Members of a cone with a zero leading member are
+       fixed to 0, members fixed to 0 are dropped from their cones. Cones
+       satisfied by every point in the bounds are dropped.
+  <li> Fixed columns that are not in a cone are substituted out.
+  <li> When transformations are allowed, continuous singleton columns
+       with zero cost are moved into the bounds of their row and binary
+       coefficients of one sided rows are tightened.
+  </ul>
 
- */
+  Passes stop when nothing changes. Bound tightening and row, cone and
+  coefficient changes keep every feasible solution of the reduced problem
+  feasible for the original one, only removed columns need postsolve. They
+  are kept in a stack, postsolve() gives the values of the original columns.
+*/
 
-class DcoPresolve: virtual public OsiPresolve {
-#if defined(__OA__)
-  OsiSolverInterface * origModel_;
-  OsiSolverInterface * presolvedModel_;
-#else
-  OsiConicSolverInterface * origModel_;
-  OsiConicSolverInterface * presolvedModel_;
-#endif
+class DcoPresolve: public DcoBoundTightener {
+  ///@name Original problem sizes
+  //@{
+  int numCols_;
+  int numRows_;
+  int numCones_;
+  //@}
+  ///@name Working problem, indexed by original columns, rows and cones.
+  //@{
+  /// Column bounds, bounds of DcoBoundTightener point to these.
+  std::vector<double> colLB_;
+  std::vector<double> colUB_;
+  std::vector<double> objCoef_;
+  /// Entries of the rows.
+  std::vector<std::vector<int> > rowInd_;
+  std::vector<std::vector<double> > rowVal_;
+  std::vector<double> rowLB_;
+  std::vector<double> rowUB_;
+  /// Rows of the columns.
+  std::vector<std::vector<int> > colRows_;
+  /// Number of cones a column is member of.
+  std::vector<int> colNumCones_;
+  /// Members and types of the cones, 1 for Lorentz, 2 for rotated.
+  std::vector<std::vector<int> > coneMembers_;
+  std::vector<int> coneType_;
+  std::vector<bool> colRemoved_;
+  std::vector<bool> rowRemoved_;
+  std::vector<bool> coneRemoved_;
+  //@}
+  /// Objective value of the removed columns.
+  double objOffset_;
+  ///@name Postsolve stack
+  //@{
+  std::vector<DcoPostsolveStep> steps_;
+  std::vector<int> stepInd_;
+  std::vector<double> stepVal_;
+  /// colMap_[i] is the original index of column i of the reduced problem.
+  std::vector<int> colMap_;
+  /// Index of the original columns in the reduced problem, -1 if removed.
+  std::vector<int> reducedIndex_;
+  //@}
+  ///@name Statistics
+  //@{
+  int numPasses_;
+  int numCoefChanged_;
+  //@}
+
+  /// Compute smallest and largest activity of row, number of infinite
+  /// contributions are counted separately.
+  void rowActivity(int row, double & minAct, int & minInf, double & maxAct,
+                   int & maxInf) const;
+  /// Remove entry of col from row, returns its coefficient.
+  double removeEntry(int row, int col);
+  /// Remove row.
+  void removeRow(int row);
+  /// Remove cone.
+  void removeCone(int cone);
+  ///@name Reductions, return the number of changes.
+  //@{
+  int presolveRowSingletons();
+  int tightenRowBounds();
+  int tightenConeBounds();
+  int removeRedundantRows();
+  int presolveCones();
+  int removeFixedCols(bool keepIntegers);
+  int removeSingletonCols();
+  int tightenCoefficients();
+  //@}
 public:
   ///@name Constructors and Destructor
   //@{
-#if defined(__OA__)
-  DcoPresolve(OsiSolverInterface * origModel);
-#else
-  DcoPresolve(OsiConicSolverInterface * origModel);
-#endif
-  virtual ~DcoPresolve();
+  /// Copy the problem rowLB <= matrix x <= rowUB, colLB <= x <= colUB and
+  /// cones in DcoModel form. Only the linear rows are read from rowLB and
+  /// rowUB.
+  DcoPresolve(int numCols, int numRows, CoinPackedMatrix const * matrix,
+              double const * colLB, double const * colUB,
+              double const * objCoef, int const * isInteger,
+              double const * rowLB, double const * rowUB, int numCones,
+              int const * coneStart, int const * coneMembers,
+              int const * coneType);
+  /// Destructor.
+  ~DcoPresolve();
   //@}
 
   ///@name Presolve Functions
   //@{
-  /// Preprocess the given model and store pointer to the pre-processed
-  /// copy in presolvedModel_;
-  void presolve();
-#if defined(__OA__)
-  /// Get preprocessed problem.
-  OsiSolverInterface * presolvedModel();
-#else
-  /// Get preprocessed problem.
-  OsiConicSolverInterface * presolvedModel();
-#endif
+  /// Run at most numPass passes. Columns within tol of being fixed are
+  /// fixed and rows within tol of being redundant are dropped. Integer
+  /// columns are not removed if keepIntegers is true, singleton columns and
+  /// coefficients are presolved only if transform is true. Returns false
+  /// if the problem is found infeasible.
+  bool presolve(int numPass, double tol, bool keepIntegers, bool transform);
+  /// Get the reduced problem in DcoModel form, arrays are allocated with
+  /// new[] and owned by the caller. Conic row bounds, 0 and infinity,
+  /// follow the linear rows in rowLB and rowUB.
+  void getProblem(int & numCols, int & numRows, double *& colLB,
+                  double *& colUB, double *& objCoef, int *& isInteger,
+                  int & numInteger, int *& integerCols, double *& rowLB,
+                  double *& rowUB, CoinPackedMatrix *& matrix,
+                  int & numCones, int *& coneStart, int *& coneMembers,
+                  int *& coneType) const;
+  /// Get objective value of the removed columns.
+  double objOffset() const { return objOffset_; }
   //@}
 
-  bool improve_bounds(DcoModel * model);
+  ///@name Postsolve Functions
+  //@{
+  /// Get number of columns of the original problem.
+  int numOrigCols() const { return numCols_; }
+  /// Get index of original column col in the reduced problem, -1 if it is
+  /// removed.
+  int reducedIndex(int col) const { return reducedIndex_[col]; }
+  /// Compute values of the original columns, origValues, from values of the
+  /// reduced problem.
+  void postsolve(double const * values, double * origValues) const;
+  //@}
 
-  ///@name Postsolve Function
+  ///@name Statistics
   //@{
-  virtual void postsolve(bool updateStatus=true);
+  int numPasses() const { return numPasses_; }
+  int numCoefChanged() const { return numCoefChanged_; }
+  int numRemovedCols() const { return numCols_ - colMap_.size(); }
+  int numRemovedRows() const;
+  int numRemovedCones() const;
   //@}
 private:
+  /// Disable default constructor.
+  DcoPresolve();
   /// Disable copy constructor.
   DcoPresolve(DcoPresolve const & other);
   /// Disable copy assignment operator.
@@ -0,0 +1,330 @@
+#include "DcoPropagator.hpp"
+#include "DcoImplications.hpp"
+
+#include <CoinPackedMatrix.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+/// Bounds larger than this in absolute value are infinite.
+static double const dcoPropagatorInfinity = 1e20;
+/// Rows violated by less than this, relative to their bounds, are feasible.
+static double const dcoPropagatorFeasTol = 1e-6;
+/// Implied bounds of continuous columns are relaxed by this, relative to
+/// their magnitude.
+static double const dcoPropagatorRelax = 1e-7;
+/// Bounds of continuous columns are changed only if they shrink the domain
+/// by more than this share of its width.
+static double const dcoPropagatorMinShrink = 0.05;
+
+DcoPropagator::DcoPropagator(int numCols, int numRows,
+                             CoinPackedMatrix const * matrix,
+                             double const * rowLB, double const * rowUB,
+                             int const * isInteger, int numCones,
+                             int const * coneStart, int const * coneMembers,
+                             int const * coneType):
+  DcoBoundTightener(numCols, isInteger),
+  numCols_(numCols), numRows_(numRows), numCones_(numCones),
+  rowLB_(rowLB, rowLB+numRows), rowUB_(rowUB, rowUB+numRows),
+  coneStart_(1, 0), implications_(NULL), minAct_(numRows), maxAct_(numRows),
+  minInf_(numRows), maxInf_(numRows), actStamp_(numRows, 0), stamp_(0),
+  rowQueued_(numRows, false), coneQueued_(numCones, false),
+  isLowerChanged_(numCols, false), isUpperChanged_(numCols, false),
+  numCalls_(0), numInfeasible_(0) {
+  minShrink_ = dcoPropagatorMinShrink;
+  relax_ = dcoPropagatorRelax;
+  // cone arrays may be NULL when there is no cone.
+  for (int i=0; i<numCones_; ++i) {
+    coneMembers_.insert(coneMembers_.end(), coneMembers+coneStart[i],
+                        coneMembers+coneStart[i+1]);
+    coneStart_.push_back(coneMembers_.size());
+    coneType_.push_back(coneType[i]);
+  }
+  CoinPackedMatrix row_matrix;
+  if (matrix->isColOrdered()) {
+    row_matrix.reverseOrderedCopyOf(*matrix);
+    matrix = &row_matrix;
+  }
+  // rows, count entries of the columns on the way.
+  std::vector<int> col_size(numCols_, 0);
+  rowStart_.push_back(0);
+  for (int i=0; i<numRows_; ++i) {
+    CoinShallowPackedVector row = matrix->getVector(i);
+    for (int k=0; k<row.getNumElements(); ++k) {
+      if (row.getElements()[k]!=0.0) {
+        rowInd_.push_back(row.getIndices()[k]);
+        rowVal_.push_back(row.getElements()[k]);
+        col_size[row.getIndices()[k]]++;
+      }
+    }
+    rowStart_.push_back(rowInd_.size());
+  }
+  // columns
+  colStart_.resize(numCols_+1, 0);
+  for (int i=0; i<numCols_; ++i) {
+    colStart_[i+1] = colStart_[i] + col_size[i];
+  }
+  colRows_.resize(rowInd_.size());
+  colVal_.resize(rowInd_.size());
+  std::vector<int> pos(colStart_.begin(), colStart_.end()-1);
+  for (int i=0; i<numRows_; ++i) {
+    for (int k=rowStart_[i]; k<rowStart_[i+1]; ++k) {
+      int col = rowInd_[k];
+      colRows_[pos[col]] = i;
+      colVal_[pos[col]] = rowVal_[k];
+      pos[col]++;
+    }
+  }
+  // cones of the columns
+  std::fill(col_size.begin(), col_size.end(), 0);
+  for (unsigned int k=0; k<coneMembers_.size(); ++k) {
+    col_size[coneMembers_[k]]++;
+  }
+  colConeStart_.resize(numCols_+1, 0);
+  for (int i=0; i<numCols_; ++i) {
+    colConeStart_[i+1] = colConeStart_[i] + col_size[i];
+  }
+  colCones_.resize(coneMembers_.size());
+  pos.assign(colConeStart_.begin(), colConeStart_.end()-1);
+  for (int i=0; i<numCones_; ++i) {
+    for (int k=coneStart_[i]; k<coneStart_[i+1]; ++k) {
+      colCones_[pos[coneMembers_[k]]++] = i;
+    }
+  }
+}
+
+DcoPropagator::~DcoPropagator() {
+}
+
+void DcoPropagator::computeActivity(int row) {
+  int start = rowStart_[row];
+  int size = rowStart_[row+1] - start;
+  if (size==0) {
+    activity(0, NULL, NULL, minAct_[row], minInf_[row], maxAct_[row],
+             maxInf_[row]);
+  }
+  else {
+    activity(size, &rowInd_[start], &rowVal_[start], minAct_[row],
+             minInf_[row], maxAct_[row], maxInf_[row]);
+  }
+  actStamp_[row] = stamp_;
+}
+
+void DcoPropagator::updateActivity(int col, bool lower, double oldBound,
+                                   double newBound) {
+  bool old_inf = fabs(oldBound)>=dcoPropagatorInfinity;
+  for (int k=colStart_[col]; k<colStart_[col+1]; ++k) {
+    int row = colRows_[k];
+    if (actStamp_[row]!=stamp_) {
+      // not computed yet, it will be computed from the new bounds.
+      continue;
+    }
+    double a = colVal_[k];
+    // lower bound gives the smallest activity for positive coefficients.
+    bool min_side = lower==(a>0.0);
+    double & act = min_side ? minAct_[row] : maxAct_[row];
+    int & num_inf = min_side ? minInf_[row] : maxInf_[row];
+    if (old_inf) {
+      num_inf--;
+    }
+    else {
+      act -= a*oldBound;
+    }
+    act += a*newBound;
+  }
+}
+
+void DcoPropagator::queueColumn(int col) {
+  for (int k=colStart_[col]; k<colStart_[col+1]; ++k) {
+    int row = colRows_[k];
+    if (!rowQueued_[row]) {
+      rowQueued_[row] = true;
+      rowQueue_.push_back(row);
+    }
+  }
+  for (int k=colConeStart_[col]; k<colConeStart_[col+1]; ++k) {
+    int cone = colCones_[k];
+    if (!coneQueued_[cone]) {
+      coneQueued_[cone] = true;
+      coneQueue_.push_back(cone);
+    }
+  }
+  queueImplications(col);
+}
+
+void DcoPropagator::queueImplications(int col) {
+  if (implications_==NULL or !isInteger_[col] or lb_[col]!=ub_[col] or
+      (lb_[col]!=0.0 and lb_[col]!=1.0)) {
+    return;
+  }
+  int value = static_cast<int>(lb_[col]);
+  if (!implications_->implied(col, value).empty()) {
+    implQueue_.push_back(col);
+  }
+}
+
+void DcoPropagator::applyImplications(int col) {
+  int value = static_cast<int>(lb_[col]);
+  std::vector<DcoImpliedBound> const & implied =
+    implications_->implied(col, value);
+  for (unsigned int k=0; k<implied.size() and !infeasible_; ++k) {
+    if (implied[k].sense=='L') {
+      tightenLower(implied[k].col, implied[k].bound);
+    }
+    else {
+      tightenUpper(implied[k].col, implied[k].bound);
+    }
+  }
+}
+
+void DcoPropagator::boundChanged(int col, bool lower, double oldBound,
+                                 double newBound) {
+  updateActivity(col, lower, oldBound, newBound);
+  std::vector<int> & changed = lower ? lowerChanged_ : upperChanged_;
+  std::vector<bool> & is_changed = lower ? isLowerChanged_ : isUpperChanged_;
+  if (!is_changed[col]) {
+    is_changed[col] = true;
+    changed.push_back(col);
+  }
+  queueColumn(col);
+}
+
+void DcoPropagator::propagateRow(int row) {
+  double lb = rowLB_[row];
+  double ub = rowUB_[row];
+  bool has_lb = lb>-dcoPropagatorInfinity;
+  bool has_ub = ub<dcoPropagatorInfinity;
+  if (!has_lb and !has_ub) {
+    return;
+  }
+  if (actStamp_[row]!=stamp_) {
+    computeActivity(row);
+  }
+  double scale = std::max(has_lb ? fabs(lb) : 0.0, has_ub ? fabs(ub) : 0.0);
+  double feas_tol = dcoPropagatorFeasTol*std::max(1.0, scale);
+  if ((has_ub and minInf_[row]==0 and minAct_[row]>ub+feas_tol) or
+      (has_lb and maxInf_[row]==0 and maxAct_[row]<lb-feas_tol)) {
+    infeasible_ = true;
+    return;
+  }
+  // bounds are implied only if at most one contribution is infinite.
+  if ((!has_ub or minInf_[row]>1) and (!has_lb or maxInf_[row]>1)) {
+    return;
+  }
+  for (int k=rowStart_[row]; k<rowStart_[row+1] and !infeasible_; ++k) {
+    int col = rowInd_[k];
+    double a = rowVal_[k];
+    double low = a>0.0 ? lb_[col] : ub_[col];
+    double high = a>0.0 ? ub_[col] : lb_[col];
+    bool low_inf = fabs(low)>=dcoPropagatorInfinity;
+    bool high_inf = fabs(high)>=dcoPropagatorInfinity;
+    // a x <= ub - smallest activity of the other entries
+    if (has_ub and minInf_[row]-(low_inf ? 1 : 0)==0) {
+      double rest_min = minAct_[row] - (low_inf ? 0.0 : a*low);
+      double bound = (ub-rest_min)/a;
+      a>0.0 ? tightenUpper(col, bound) : tightenLower(col, bound);
+    }
+    if (infeasible_) {
+      break;
+    }
+    // a x >= lb - largest activity of the other entries, bounds of col may
+    // have changed above.
+    high = a>0.0 ? ub_[col] : lb_[col];
+    high_inf = fabs(high)>=dcoPropagatorInfinity;
+    if (has_lb and maxInf_[row]-(high_inf ? 1 : 0)==0) {
+      double rest_max = maxAct_[row] - (high_inf ? 0.0 : a*high);
+      double bound = (lb-rest_max)/a;
+      a>0.0 ? tightenLower(col, bound) : tightenUpper(col, bound);
+    }
+  }
+}
+
+void DcoPropagator::propagateCone(int cone) {
+  tightenCone(coneStart_[cone+1]-coneStart_[cone],
+              &coneMembers_[coneStart_[cone]], coneType_[cone]);
+}
+
+bool DcoPropagator::propagate(double * colLB, double * colUB, int col,
+                              int numPass) {
+  numCalls_++;
+  lb_ = colLB;
+  ub_ = colUB;
+  // activities of the last call are invalidated.
+  stamp_++;
+  infeasible_ = false;
+  for (unsigned int i=0; i<lowerChanged_.size(); ++i) {
+    isLowerChanged_[lowerChanged_[i]] = false;
+  }
+  lowerChanged_.clear();
+  for (unsigned int i=0; i<upperChanged_.size(); ++i) {
+    isUpperChanged_[upperChanged_[i]] = false;
+  }
+  upperChanged_.clear();
+  if (col<0) {
+    for (int i=0; i<numRows_; ++i) {
+      rowQueued_[i] = true;
+      rowQueue_.push_back(i);
+    }
+    for (int i=0; i<numCones_; ++i) {
+      coneQueued_[i] = true;
+      coneQueue_.push_back(i);
+    }
+    for (int i=0; i<numCols_; ++i) {
+      queueImplications(i);
+    }
+  }
+  else {
+    queueColumn(col);
+  }
+  int work_limit = numPass*(numRows_+numCones_);
+  int work = 0;
+  // rows and cones queued while a round is processed go to the next round.
+  std::vector<int> rows;
+  std::vector<int> cones;
+  std::vector<int> fixed;
+  while (!infeasible_ and work<work_limit and
+         (!rowQueue_.empty() or !coneQueue_.empty() or
+          !implQueue_.empty())) {
+    fixed.swap(implQueue_);
+    implQueue_.clear();
+    for (unsigned int i=0; i<fixed.size() and !infeasible_ and
+           work<work_limit; ++i) {
+      applyImplications(fixed[i]);
+      work++;
+    }
+    rows.swap(rowQueue_);
+    rowQueue_.clear();
+    for (unsigned int i=0; i<rows.size(); ++i) {
+      rowQueued_[rows[i]] = false;
+    }
+    for (unsigned int i=0; i<rows.size() and !infeasible_ and
+           work<work_limit; ++i) {
+      propagateRow(rows[i]);
+      work++;
+    }
+    cones.swap(coneQueue_);
+    coneQueue_.clear();
+    for (unsigned int i=0; i<cones.size(); ++i) {
+      coneQueued_[cones[i]] = false;
+    }
+    for (unsigned int i=0; i<cones.size() and !infeasible_ and
+           work<work_limit; ++i) {
+      propagateCone(cones[i]);
+      work++;
+    }
+  }
+  // drop what is left in the queues.
+  implQueue_.clear();
+  for (unsigned int i=0; i<rowQueue_.size(); ++i) {
+    rowQueued_[rowQueue_[i]] = false;
+  }
+  rowQueue_.clear();
+  for (unsigned int i=0; i<coneQueue_.size(); ++i) {
+    coneQueued_[coneQueue_[i]] = false;
+  }
+  coneQueue_.clear();
+  if (infeasible_) {
+    numInfeasible_++;
+  }
+  return !infeasible_;
+}
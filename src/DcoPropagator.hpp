@@ -0,0 +1,160 @@
+#ifndef DcoPropagator_hpp_
+#define DcoPropagator_hpp_
+
+#include "DcoBoundTightener.hpp"
+
+#include <vector>
+
+class CoinPackedMatrix;
+class DcoImplications;
+
+/*!
+  DcoPropagator tightens the column bounds of a node before its subproblem
+  is solved. It works on the core rows of the model, rowLB <= Ax <= rowUB,
+  and the cones. propagate() takes the node bounds and
+
+  <ul>
+  <li> tightens the column bounds implied by the smallest and the largest
+       activities of the linear rows (FBBT). Activities are computed once
+       per call, when a row is visited first, and updated as the bounds of
+       its columns change.
+  <li> bounds cone members by the leading variables and the leading
+       variables by the box of the members, for x_1 >= ||x_2n|| and
+       2x_1x_2 >= ||x_3n||^2.
+  <li> applies the implications found by probing, see DcoImplications,
+       when a binary column is fixed.
+  </ul>
+
+  Rows and cones of the columns whose bounds change are queued until
+  nothing changes or the work limit is reached. When a column is given only
+  its rows and cones are queued first, this is the branching column of a
+  node whose parent bounds are already propagated.
+
+  Bounds of integer columns are rounded. Bounds of continuous columns are
+  changed only if they shrink the domain considerably and they are relaxed
+  by a small amount, so that numerical errors in the activities do not cut
+  off feasible points.
+*/
+
+class DcoPropagator: public DcoBoundTightener {
+  ///@name Problem data
+  //@{
+  int numCols_;
+  int numRows_;
+  int numCones_;
+  /// Rows in compressed form.
+  std::vector<int> rowStart_;
+  std::vector<int> rowInd_;
+  std::vector<double> rowVal_;
+  std::vector<double> rowLB_;
+  std::vector<double> rowUB_;
+  /// Rows of the columns and coefficients of the columns in them.
+  std::vector<int> colStart_;
+  std::vector<int> colRows_;
+  std::vector<double> colVal_;
+  /// Cones, members in DcoModel form, type 1 for Lorentz, 2 for rotated.
+  std::vector<int> coneStart_;
+  std::vector<int> coneMembers_;
+  std::vector<int> coneType_;
+  /// Cones of the columns.
+  std::vector<int> colConeStart_;
+  std::vector<int> colCones_;
+  /// Implications of binary columns, not owned. NULL if there is none.
+  DcoImplications const * implications_;
+  //@}
+  ///@name Work data of a propagate() call, bounds propagated are the
+  /// bounds of DcoBoundTightener.
+  //@{
+  /// Activities of the rows, finite part and number of infinite
+  /// contributions. They are valid if actStamp_ is stamp_.
+  std::vector<double> minAct_;
+  std::vector<double> maxAct_;
+  std::vector<int> minInf_;
+  std::vector<int> maxInf_;
+  std::vector<int> actStamp_;
+  int stamp_;
+  /// Queued rows and cones.
+  std::vector<int> rowQueue_;
+  std::vector<int> coneQueue_;
+  std::vector<bool> rowQueued_;
+  std::vector<bool> coneQueued_;
+  /// Fixed binary columns whose implications are not applied yet.
+  std::vector<int> implQueue_;
+  /// Columns whose lower and upper bounds are tightened.
+  std::vector<int> lowerChanged_;
+  std::vector<int> upperChanged_;
+  std::vector<bool> isLowerChanged_;
+  std::vector<bool> isUpperChanged_;
+  //@}
+  ///@name Statistics
+  //@{
+  int numCalls_;
+  int numInfeasible_;
+  //@}
+
+  /// Compute activities of row from the current bounds.
+  void computeActivity(int row);
+  /// Update activities of the rows of col for its bound changing from
+  /// oldBound to newBound.
+  void updateActivity(int col, bool lower, double oldBound, double newBound);
+  /// Update activities, record the change and queue rows and cones of
+  /// col.
+  virtual void boundChanged(int col, bool lower, double oldBound,
+                            double newBound);
+  /// Queue rows and cones of col, and its implications.
+  void queueColumn(int col);
+  /// Queue col if it is a fixed binary with implications.
+  void queueImplications(int col);
+  /// Tighten bounds implied by fixed binary col.
+  void applyImplications(int col);
+  ///@name Propagation of a single row or cone
+  //@{
+  void propagateRow(int row);
+  void propagateCone(int cone);
+  //@}
+public:
+  ///@name Constructors and Destructor
+  //@{
+  /// Copy linear rows rowLB <= matrix x <= rowUB and cones in DcoModel
+  /// form.
+  DcoPropagator(int numCols, int numRows, CoinPackedMatrix const * matrix,
+                double const * rowLB, double const * rowUB,
+                int const * isInteger, int numCones, int const * coneStart,
+                int const * coneMembers, int const * coneType);
+  /// Destructor.
+  ~DcoPropagator();
+  //@}
+  /// Set implications applied when binary columns are fixed, they should
+  /// be globally valid. Pass NULL to not use implications.
+  void setImplications(DcoImplications const * implications) {
+    implications_ = implications;
+  }
+
+  ///@name Propagation
+  //@{
+  /// Propagate bounds colLB and colUB in place. Only rows and cones of col
+  /// are queued first, all of them if col is negative. At most numPass
+  /// visits per row and cone are made on average. Returns false if the
+  /// bounds are found infeasible.
+  bool propagate(double * colLB, double * colUB, int col, int numPass);
+  /// Get columns whose lower bounds are tightened in the last call.
+  std::vector<int> const & lowerChanged() const { return lowerChanged_; }
+  /// Get columns whose upper bounds are tightened in the last call.
+  std::vector<int> const & upperChanged() const { return upperChanged_; }
+  //@}
+
+  ///@name Statistics
+  //@{
+  int numCalls() const { return numCalls_; }
+  int numInfeasible() const { return numInfeasible_; }
+  //@}
+private:
+  /// Disable default constructor.
+  DcoPropagator();
+  /// Disable copy constructor.
+  DcoPropagator(DcoPropagator const & other);
+  /// Disable copy assignment operator.
+  DcoPropagator & operator=(DcoPropagator const & rhs);
+};
+
+#endif
@@ -24,6 +24,21 @@ BcpsSolution * DcoSolution::selectFractional(const double etol) const {
   return NULL;
 }
 
+void DcoSolution::print(std::ostream & os) const {
+  if (broker_==NULL) {
+    BcpsSolution::print(os);
+    return;
+  }
+  DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
+  std::vector<double> values;
+  model->postsolve(this, values);
+  for (unsigned int i=0; i<values.size(); ++i) {
+    if (values[i]!=0.0) {
+      os << "x[" << i << "] = " << values[i] << std::endl;
+    }
+  }
+}
+
 /// Encodes the solution into AlpsEncoded object and return pointer to it.
 AlpsReturnStatus DcoSolution::encode(AlpsEncoded * encoded) const {
   // get pointers for message logging
@@ -22,6 +22,9 @@ public:
   virtual ~DcoSolution();
   virtual BcpsSolution * selectNonzeros(const double etol=1e-5) const;
   virtual BcpsSolution * selectFractional(const double etol=1e-5) const;
+  /// Print nonzero values of the original columns, the solution is
+  /// postsolved if the problem is presolved.
+  virtual void print(std::ostream & os) const;
 
   ///@name Encode and Decode functions
   //@{
@@ -3,6 +3,7 @@
 
 // Osi headers
 #include <OsiRowCut.hpp>
+#include <OsiCuts.hpp>
 
 // Disco headers
 #include "DcoTreeNode.hpp"
@@ -17,6 +18,9 @@
 #include "DcoBranchObject.hpp"
 #include "DcoHeuristic.hpp"
 #include "DcoHeurRounding.hpp"
+#include "DcoHeurExecutor.hpp"
+#include "DcoImplications.hpp"
+#include "DcoPropagator.hpp"
 
 // STL headers
 #include <vector>
@@ -36,6 +40,18 @@ struct Bound {
   SparseVector upper;
 };
 
+/// Reduced costs smaller than this in absolute value are not used for
+/// fixing.
+static double const dcoRcFixingDjTol = 1e-6;
+/// Columns within this of a bound are at the bound, bounds implied for
+/// integer columns are rounded with it.
+static double const dcoRcFixingTol = 1e-6;
+/// Bounds of continuous columns are changed only if they shrink the domain
+/// by more than this share of its width.
+static double const dcoRcFixingMinShrink = 0.05;
+/// Implied bounds larger than this in absolute value are not used.
+static double const dcoRcFixingMaxBound = 1e8;
+
 
 DcoTreeNode::DcoTreeNode() {
   bcpStats_.numBoundIter_ = 0;
@@ -48,6 +64,7 @@ DcoTreeNode::DcoTreeNode() {
   bcpStats_.lastObjVal_ = 0.0;
   bcpStats_.startObjVal_ = 0.0;
   bcpStats_.numMilpIter_ = 0;
+  bcpStats_.roundStart_ = -1.0;
   bcpStats_.inactive_.clear();
   bcpStats_.generatorIndex_.clear();
 }
@@ -65,6 +82,7 @@ DcoTreeNode::DcoTreeNode(AlpsNodeDesc *& desc) {
   bcpStats_.lastObjVal_ = 0.0;
   bcpStats_.startObjVal_ = 0.0;
   bcpStats_.numMilpIter_ = 0;
+  bcpStats_.roundStart_ = -1.0;
   bcpStats_.inactive_.clear();
   bcpStats_.generatorIndex_.clear();
 }
@@ -283,28 +301,62 @@ int DcoTreeNode::generateConstraints(BcpsConstraintPool * conPool, int type) {
   CoinMessageHandler * message_handler = disco_model->dcoMessageHandler_;
   //CoinMessages * messages = disco_model->dcoMessages_;
 
+  // collect generators we will use in this round
+  std::vector<DcoConGenerator*> generators;
   std::map<DcoConstraintType, DcoConGenerator*>::iterator it;
-  std::map<DcoConstraintType, DcoConGenerator*> con_generators = disco_model->conGenerators();
+  std::map<DcoConstraintType, DcoConGenerator*> & con_generators =
+    disco_model->conGenerators();
   for (it=con_generators.begin(); it != con_generators.end(); ++it) {
     bool do_use = false;
     DcoConGenerator * cg = it->second;
     // decide whether we should use this cut generator with respect to the
     // specified cut strategy
     decide_using_cg(do_use, cg, type);
-    if (!do_use) {
-      // jump to the next geenrator if we will not use this one.
-      continue;
+    if (do_use) {
+      generators.push_back(cg);
     }
-    int pre_num_cons = conPool->getNumConstraints();
-    double start_time = CoinCpuTime();
-    // Call constraint generator
-    //bool must_resolve = cg->generateConstraints(*conPool);
-    cg->generateConstraints(*conPool);
-    double cut_time = CoinCpuTime() - start_time;
+  }
+  int num_gens = generators.size();
+  std::vector<int> num_cons(num_gens, 0);
+  std::vector<double> cut_times(num_gens, 0.0);
+  // remember the round to credit the bound improvement it brings, rounds
+  // that end up with a non-optimal subproblem are not credited.
+  bcpStats_.lastGens_ = generators;
+  bcpStats_.lastUsed_.resize(num_gens);
+  for (int i=0; i<num_gens; ++i) {
+    bcpStats_.lastUsed_[i] = generators[i]->stats().numConsUsed();
+  }
+  int num_threads = disco_model->dcoPar()->entry(DcoParams::cutNumThreads);
+  if (num_threads>1 and num_gens>1) {
+    // separate on cloned solvers in parallel, then add cuts to the pool in
+    // the generator order so the pool does not depend on thread timing.
+    std::vector<OsiCuts> cuts;
+    DcoConGenerator::generateCutsParallel(generators, disco_model->solver(),
+                                          cuts, cut_times, num_threads);
+    for (int i=0; i<num_gens; ++i) {
+      num_cons[i] = generators[i]->addCutsToPool(cuts[i], *conPool);
+    }
+  }
+  else {
+    for (int i=0; i<num_gens; ++i) {
+      int pre_num_cons = conPool->getNumConstraints();
+      // wall clock as in the parallel path, so that times of both paths
+      // compare to the same node time in DcoConGenerator::adapt().
+      double start_time = CoinWallclockTime();
+      // Call constraint generator
+      //bool must_resolve = cg->generateConstraints(*conPool);
+      generators[i]->generateConstraints(*conPool);
+      cut_times[i] = CoinWallclockTime() - start_time;
+      num_cons[i] = conPool->getNumConstraints() - pre_num_cons;
+    }
+  }
+
+  for (int i=0; i<num_gens; ++i) {
+    DcoConGenerator * cg = generators[i];
     // Statistics
-    cg->stats().addTime(cut_time);
+    cg->stats().addTime(cut_times[i]);
     cg->stats().addNumCalls(1);
-    int num_cons_generated = conPool->getNumConstraints() - pre_num_cons;
+    int num_cons_generated = num_cons[i];
     if (num_cons_generated == 0) {
       cg->stats().addNumNoConsCalls(1);
     }
@@ -317,12 +369,39 @@ int DcoTreeNode::generateConstraints(BcpsConstraintPool * conPool, int type) {
     debug_msg << "[" << broker()->getProcRank() << "] Called "
               << cg->name() << ", generated "
               << num_cons_generated << " cuts in "
-              << cut_time << " seconds.";
+              << cut_times[i] << " seconds.";
     message_handler->message(0, "Dco", debug_msg.str().c_str(),
                              'G', DISCO_DLOG_CUT)
       << CoinMessageEol;
     // end of debug
   }
+  // global bound changes found by probing are written to the root
+  // description, so that nodes created from now on inherit them. Other
+  // nodes get them from the variable bounds when they branch. Subtree roots
+  // received in parallel runs have no parent either, but their
+  // descriptions have local bounds, the search tree root is at depth 0.
+  DcoImplications * implications = disco_model->implications();
+  if (!implications->tightened().empty()) {
+    if (depth_==0) {
+      // notes(aykut) root description has full bounds, entries are indexed
+      // by columns.
+      std::vector<BcpsVariable*> & vars = disco_model->getVariables();
+      std::vector<int> const & cols = implications->tightened();
+      DcoNodeDesc * desc = getDesc();
+      for (unsigned int i=0; i<cols.size(); ++i) {
+        desc->vars()->lbHard.entries[cols[i]] = vars[cols[i]]->getLbHard();
+        desc->vars()->ubHard.entries[cols[i]] = vars[cols[i]]->getUbHard();
+      }
+    }
+    std::stringstream debug_msg;
+    debug_msg << "[" << broker()->getProcRank() << "] Probing tightened "
+              << implications->tightened().size() << " global bounds, "
+              << implications->numImplications() << " implications stored.";
+    message_handler->message(0, "Dco", debug_msg.str().c_str(),
+                             'G', DISCO_DLOG_CUT)
+      << CoinMessageEol;
+    implications->clearTightened();
+  }
   // return value will make sense when DcoTreeNode::process is implemented
   // in Bcps level.
   return 0;
@@ -356,8 +435,9 @@ void DcoTreeNode::decide_using_cg(bool & do_use,
         do_use = (depth_ == 0)  ? true : false;
       }
       else if (strategy==DcoCutStrategyAuto) {
-        // moreover disable generator if it does not do well
-        do_use = (index_ % cg->frequency() == 0) ? true : false;
+        // frequency and depth limit are adapted by DcoConGenerator::adapt()
+        do_use = (index_ % cg->frequency() == 0 and
+                  depth_ <= cg->maxDepth()) ? true : false;
       }
       else if (strategy==DcoCutStrategyPeriodic) {
         do_use = (index_ % cg->frequency() == 0) ? true : false;
@@ -487,10 +567,19 @@ int DcoTreeNode::boundingLoop(bool isRoot, bool rampUp) {
   BcpsConstraintPool * constraintPool = new BcpsConstraintPool();
   BcpsVariablePool * variablePool = new BcpsVariablePool();
   installSubProblem();
+  // nodes proven infeasible by propagation are fathomed without solving.
+  if (!propagateBounds()) {
+    delete constraintPool;
+    delete variablePool;
+    return AlpsReturnStatusOk;
+  }
+  // parent bound, to measure what branching gives.
+  double parent_quality = quality_;
 
   while (keepBounding) {
     keepBounding = false;
     // solve subproblem corresponds to this node
+    double bound_start = CoinWallclockTime();
     BcpsSubproblemStatus subproblem_status = bound();
     // update number of iterations statistics
     model->addNumRelaxIterations();
@@ -498,6 +587,11 @@ int DcoTreeNode::boundingLoop(bool isRoot, bool rampUp) {
     if (bcpStats_.numBoundIter_==0) {
       bcpStats_.startObjVal_ = model->solver()->getObjValue();
       bcpStats_.lastObjVal_ = model->solver()->getObjValue();
+      if (parent_ and subproblem_status==BcpsSubproblemStatusOptimal and
+          parent_quality>-ALPS_OBJ_MAX) {
+        model->addBranchSample(quality_-parent_quality,
+                               CoinWallclockTime()-bound_start);
+      }
     }
     else {
       bcpStats_.totalImp_ = model->objSense()*
@@ -505,6 +599,21 @@ int DcoTreeNode::boundingLoop(bool isRoot, bool rampUp) {
       bcpStats_.lastImp_ = model->objSense()*
         (model->solver()->getObjValue()-bcpStats_.lastObjVal_);
       bcpStats_.lastObjVal_ = model->solver()->getObjValue();
+      if (subproblem_status==BcpsSubproblemStatusOptimal) {
+        creditCutGenerators();
+      }
+    }
+    // close the pending cut round
+    if (bcpStats_.roundStart_>=0.0) {
+      int max_rounds = model->dcoPar()->entry(DcoParams::cutTailOffRounds);
+      bcpStats_.roundImp_.push_back(CoinMax(bcpStats_.lastImp_, 0.0));
+      bcpStats_.roundTime_.push_back(CoinWallclockTime()-
+                                     bcpStats_.roundStart_);
+      while (static_cast<int>(bcpStats_.roundImp_.size())>max_rounds) {
+        bcpStats_.roundImp_.pop_front();
+        bcpStats_.roundTime_.pop_front();
+      }
+      bcpStats_.roundStart_ = -1.0;
     }
 
     // debug print solver status
@@ -586,7 +695,14 @@ int DcoTreeNode::boundingLoop(bool isRoot, bool rampUp) {
     if (bcpStats_.numBoundIter_==0) {
       callHeuristics();
     }
+    // solutions found by the heuristic thread since the last check
+    collectHeuristicSolutions();
 #ifdef __OA__
+    // tighten bounds with the reduced costs and the incumbent
+    if (subproblem_status==BcpsSubproblemStatusOptimal and
+        model->dcoPar()->entry(DcoParams::reducedCostFixing)) {
+      reducedCostFixing();
+    }
     // update cut stats and clean if necessary
     checkCuts();
 #endif
@@ -609,6 +725,7 @@ int DcoTreeNode::boundingLoop(bool isRoot, bool rampUp) {
       break;
     }
     else if (keepBounding and genConstraints) {
+      bcpStats_.roundStart_ = CoinWallclockTime();
       generateConstraints(constraintPool, genConstraints);
       // add constraints to the model
       applyConstraints(constraintPool);
@@ -759,72 +876,107 @@ void DcoTreeNode::checkCuts() {
       model->solver()->deleteRows(numDel, delInd);
       // resolve to correct status
       model->solver()->resolve();
+      model->invalidateRelaxedRowInf();
     }
     delete[] delInd;
     model->decreaseInitOAcuts(num_del_init_oa);
   }
 }
 
+void DcoTreeNode::creditCutGenerators() {
+  std::vector<DcoConGenerator*> & gens = bcpStats_.lastGens_;
+  if (gens.empty()) {
+    return;
+  }
+  int num_gens = gens.size();
+  std::vector<int> used(num_gens);
+  int total_used = 0;
+  for (int i=0; i<num_gens; ++i) {
+    used[i] = gens[i]->stats().numConsUsed() - bcpStats_.lastUsed_[i];
+    total_used += used[i];
+  }
+  // average node processing time, used by adaptive cut scheduling. Cut
+  // times are wall clock, so is this.
+  int num_nodes = CoinMax(broker()->getNumNodesProcessed(), 1);
+  double node_time = broker()->timer().getWallClock() / num_nodes;
+  double imp = CoinMax(bcpStats_.lastImp_, 0.0);
+  for (int i=0; i<num_gens; ++i) {
+    if (total_used>0) {
+      gens[i]->creditImprovement(imp*used[i]/total_used, depth_);
+    }
+    gens[i]->adapt(node_time);
+  }
+  gens.clear();
+  bcpStats_.lastUsed_.clear();
+}
+
 void DcoTreeNode::callHeuristics() {
   DcoModel * model = dynamic_cast<DcoModel*>(broker()->getModel());
   CoinMessageHandler * message_handler = model->dcoMessageHandler_;
   CoinMessages * messages = model->dcoMessages_;
+  // average node processing time, used by adaptive heuristic scheduling
+  int num_nodes = CoinMax(broker()->getNumNodesProcessed(), 1);
+  double node_time = broker()->timer().getCpuTime() / num_nodes;
+  DcoHeurExecutor * executor = model->heurExecutor();
+  if (executor) {
+    // heuristics run on a background thread, hand over a snapshot of this
+    // node. It is dropped if the thread is still busy with an older one.
+    // Worker measures heuristic times in wall clock, so should we.
+    node_time = broker()->timer().getWallClock() / num_nodes;
+    executor->submit(model->solver(), index_, node_time);
+    return;
+  }
   long unsigned int num_heur = model->numHeuristics();
   DcoSolution * sol = NULL;
   for (long unsigned int i=0; i<num_heur; ++i) {
     DcoHeuristic * curr = model->heuristics(i);
+    if (!curr->shouldCall(index_)) {
+      continue;
+    }
     double start_time = CoinCpuTime();
     sol = curr->searchSolution();
     double heur_time = CoinCpuTime() - start_time;
     // Statistics
-    curr->stats().addTime(heur_time);
-    curr->stats().addCalls(1);
+    curr->stats().addCall(heur_time, sol!=NULL);
+    // update call frequency and work limit from the statistics
+    curr->adapt(node_time);
     if (sol) {
-      double cutoff = model->dcoPar()->entry(DcoParams::cutoff);
-      double sense = model->dcoPar()->entry(DcoParams::objSense);
-      cutoff = sense*cutoff;
-      cutoff = CoinMin(cutoff, sol->getQuality());
-      if (sol->getQuality() <= cutoff) {
-        // set depth
-        setDepth(depth_);
-        // set index
-        setIndex(index_);
-        // Store in Alps pool
-        broker()->addKnowledge(AlpsKnowledgeTypeSolution,
-                               sol,
-                               model->objSense() * sol->getQuality());
-        double incum_value = broker()->getIncumbentValue();
-        model->solver()->setDblParam(OsiDualObjectiveLimit,
-                                     model->objSense()*incum_value);
-        // debug log
-        message_handler->message(DISCO_HEUR_SOL_FOUND, *messages)
-          << broker()->getProcRank()
-          << curr->name()
-          << sol->getQuality();
-      }
+      storeHeuristicSolution(curr, sol);
     }
     else {
       // debug message
       message_handler->message(DISCO_HEUR_NOSOL_FOUND, *messages)
         << broker()->getProcRank()
-        << curr->name();
+        << curr->name()
+        << CoinMessageEol;
     }
   }
+}
 
-  if (sol) {
-    //double comp_obj = 0.0;
-    //int num_cols = model->solver()->getNumCols();
-    //double const * obj_coef = model->solver()->getObjCoefficients();
-    //comp_obj = std::inner_product(sol->getValues(), sol->getValues()+num_cols, obj_coef, 0.0);
-    // std::cout << "==================== "
-    //           << "objective "
-    //           << "===================="
-    //           << std::endl
-    //           << comp_obj
-    //           << std::endl;
+/// Pass the solutions found by the heuristic thread to the broker.
+void DcoTreeNode::collectHeuristicSolutions() {
+  DcoModel * model = dynamic_cast<DcoModel*>(broker()->getModel());
+  DcoHeurExecutor * executor = model->heurExecutor();
+  if (executor==NULL) {
+    return;
+  }
+  DcoHeuristic * finder = NULL;
+  DcoSolution * sol = executor->popSolution(finder);
+  while (sol) {
+    storeHeuristicSolution(finder, sol);
+    sol = executor->popSolution(finder);
   }
 }
 
+/// Store solution found by the given heuristic in the broker, takes
+/// ownership of sol.
+void DcoTreeNode::storeHeuristicSolution(DcoHeuristic const * heur,
+                                         DcoSolution * sol) {
+  DcoModel * model = dynamic_cast<DcoModel*>(broker()->getModel());
+  sol->setDepth(depth_);
+  model->storeHeuristicSolution(heur, sol);
+}
+
 /// Bounding procedure to estimate quality of this node.
 BcpsSubproblemStatus DcoTreeNode::bound() {
   BcpsSubproblemStatus subproblem_status;
@@ -841,6 +993,7 @@ BcpsSubproblemStatus DcoTreeNode::bound() {
   }
   // solve problem loaded to the solver
   model->solver()->resolve();
+  model->invalidateRelaxedRowInf();
   if (model->solver()->isAbandoned()) {
     subproblem_status = BcpsSubproblemStatusAbandoned;
   }
@@ -916,6 +1069,9 @@ int DcoTreeNode::installSubProblem() {
   CoinMessageHandler * message_handler = model->dcoMessageHandler_;
   CoinMessages * messages = model->dcoMessages_;
   DcoNodeDesc * desc = dynamic_cast<DcoNodeDesc*>(getDesc());
+  // solver gets the problem of this node, cached infeasibilities are of the
+  // previous one.
+  model->invalidateRelaxedRowInf();
   // get number of columns and rows
   int numCoreCols = model->getNumCoreVariables();
   int numCoreLinearRows = model->getNumCoreLinearConstraints();
@@ -1153,6 +1309,211 @@ int DcoTreeNode::installSubProblem() {
   //  End of 7
 }
 
+void DcoTreeNode::reducedCostFixing() {
+  DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
+  CoinMessageHandler * message_handler = model->dcoMessageHandler_;
+  OsiSolverInterface * solver = model->solver();
+  // incumbent value and objective in minimization sense
+  double cutoff = broker()->getIncumbentValue();
+  if (cutoff>=ALPS_INC_MAX) {
+    return;
+  }
+  double sense = solver->getObjSense();
+  double gap = cutoff - sense*solver->getObjValue();
+  if (gap<0.0) {
+    return;
+  }
+  // solutions better than the incumbent satisfy
+  // d_j (x_j - lb_j) <= gap for columns at lower bound with d_j > 0 and
+  // d_j (x_j - ub_j) <= gap for columns at upper bound with d_j < 0.
+  std::vector<BcpsVariable*> & vars = model->getVariables();
+  int num_cols = model->getNumCoreVariables();
+  double const * lb = solver->getColLower();
+  double const * ub = solver->getColUpper();
+  double const * sol = solver->getColSolution();
+  double const * rc = solver->getReducedCost();
+  double infinity = solver->getInfinity();
+  std::vector<int> lower_cols;
+  std::vector<double> lower_val;
+  std::vector<int> upper_cols;
+  std::vector<double> upper_val;
+  for (int i=0; i<num_cols; ++i) {
+    double d = sense*rc[i];
+    if (fabs(d)<dcoRcFixingDjTol or lb[i]>=ub[i]) {
+      continue;
+    }
+    bool integer = vars[i]->getIntType()=='I';
+    if (d>0.0 and lb[i]>-infinity and
+        sol[i]<=lb[i]+dcoRcFixingTol*CoinMax(1.0, fabs(lb[i]))) {
+      double bound = lb[i] + gap/d;
+      if (fabs(bound)>dcoRcFixingMaxBound) {
+        continue;
+      }
+      if (integer) {
+        bound = floor(bound+dcoRcFixingTol);
+        if (bound>ub[i]-0.5) {
+          continue;
+        }
+      }
+      else {
+        bound += dcoRcFixingTol*CoinMax(1.0, fabs(bound));
+        if (ub[i]<infinity and
+            bound>=ub[i]-dcoRcFixingMinShrink*(ub[i]-lb[i])) {
+          continue;
+        }
+      }
+      upper_cols.push_back(i);
+      upper_val.push_back(bound);
+    }
+    else if (d<0.0 and ub[i]<infinity and
+             sol[i]>=ub[i]-dcoRcFixingTol*CoinMax(1.0, fabs(ub[i]))) {
+      double bound = ub[i] + gap/d;
+      if (fabs(bound)>dcoRcFixingMaxBound) {
+        continue;
+      }
+      if (integer) {
+        bound = ceil(bound-dcoRcFixingTol);
+        if (bound<lb[i]+0.5) {
+          continue;
+        }
+      }
+      else {
+        bound -= dcoRcFixingTol*CoinMax(1.0, fabs(bound));
+        if (lb[i]>-infinity and
+            bound<=lb[i]+dcoRcFixingMinShrink*(ub[i]-lb[i])) {
+          continue;
+        }
+      }
+      lower_cols.push_back(i);
+      lower_val.push_back(bound);
+    }
+  }
+  if (lower_cols.empty() and upper_cols.empty()) {
+    return;
+  }
+  // the current solution stays feasible, columns tightened are at their
+  // other bound.
+  double * colLB = model->colLB();
+  double * colUB = model->colUB();
+  for (unsigned int i=0; i<lower_cols.size(); ++i) {
+    solver->setColLower(lower_cols[i], lower_val[i]);
+    colLB[lower_cols[i]] = lower_val[i];
+  }
+  for (unsigned int i=0; i<upper_cols.size(); ++i) {
+    solver->setColUpper(upper_cols[i], upper_val[i]);
+    colUB[upper_cols[i]] = upper_val[i];
+  }
+  model->invalidateRelaxedRowInf();
+  DcoNodeDesc * desc = getDesc();
+  // only the search tree root has the global bounds, subtree roots
+  // received in parallel runs have no parent either.
+  bool global = depth_==0;
+  if (global) {
+    // root fixings are global, they go to the variables and to the root
+    // description. notes(aykut) root description has full bounds, entries
+    // are indexed by columns.
+    for (unsigned int i=0; i<lower_cols.size(); ++i) {
+      vars[lower_cols[i]]->setLbHard(lower_val[i]);
+      desc->vars()->lbHard.entries[lower_cols[i]] = lower_val[i];
+    }
+    for (unsigned int i=0; i<upper_cols.size(); ++i) {
+      vars[upper_cols[i]]->setUbHard(upper_val[i]);
+      desc->vars()->ubHard.entries[upper_cols[i]] = upper_val[i];
+    }
+  }
+  else {
+    desc->tightenVarSoftBound(lower_cols.size(),
+                              lower_cols.empty() ? NULL : &lower_cols[0],
+                              lower_cols.empty() ? NULL : &lower_val[0],
+                              upper_cols.size(),
+                              upper_cols.empty() ? NULL : &upper_cols[0],
+                              upper_cols.empty() ? NULL : &upper_val[0]);
+  }
+  int num_fixed = lower_cols.size() + upper_cols.size();
+  model->addNumRcFixed(global, num_fixed);
+  // debug message
+  std::stringstream debug_msg;
+  debug_msg << "[" << broker()->getProcRank() << "] Reduced cost fixing "
+            << "tightened " << num_fixed << " bounds of node " << getIndex()
+            << ", gap " << gap << ".";
+  message_handler->message(0, "Dco", debug_msg.str().c_str(),
+                           'G', DISCO_DLOG_PROCESS)
+    << CoinMessageEol;
+}
+
+bool DcoTreeNode::propagateBounds() {
+  DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
+  CoinMessageHandler * message_handler = model->dcoMessageHandler_;
+  CoinMessages * messages = model->dcoMessages_;
+  DcoPropagator * propagator = model->propagator();
+  if (propagator==NULL) {
+    return true;
+  }
+  DcoNodeDesc * desc = getDesc();
+  // bounds of the parent are propagated already, start from the branching
+  // column. Root and nodes received without their parents start from all
+  // rows and cones.
+  int col = (parent_ and desc->getBranchedInd()>=0) ?
+    desc->getBranchedInd() : -1;
+  // node bounds are in model->colLB() and model->colUB() after
+  // installSubProblem().
+  double * colLB = model->colLB();
+  double * colUB = model->colUB();
+  int num_pass = model->dcoPar()->entry(DcoParams::propagateNumPass);
+  if (!propagator->propagate(colLB, colUB, col, num_pass)) {
+    // debug message
+    message_handler->message(DISCO_SOLVER_INFEASIBLE, *messages)
+      << broker()->getProcRank()
+      << getIndex()
+      << CoinMessageEol;
+    // grumpy message
+    message_handler->message(DISCO_GRUMPY_MESSAGE_SHORT, *messages)
+      << broker()->getProcRank()
+      << broker()->timer().getTime()
+      << grumpyMessage[DISCO_GRUMPY_INFEASIBLE]
+      << getIndex()
+      << getParentIndex()
+      << grumpyDirection[desc->getBranchedDir()]
+      << CoinMessageEol;
+    // end of grumpy message
+    setStatus(AlpsNodeStatusFathomed);
+    return false;
+  }
+  // install tightened bounds and keep them as soft bounds of this node, so
+  // that the children inherit them.
+  std::vector<int> const & lower_cols = propagator->lowerChanged();
+  std::vector<int> const & upper_cols = propagator->upperChanged();
+  if (lower_cols.empty() and upper_cols.empty()) {
+    return true;
+  }
+  std::vector<double> lower_val(lower_cols.size());
+  for (unsigned int i=0; i<lower_cols.size(); ++i) {
+    lower_val[i] = colLB[lower_cols[i]];
+    model->solver()->setColLower(lower_cols[i], lower_val[i]);
+  }
+  std::vector<double> upper_val(upper_cols.size());
+  for (unsigned int i=0; i<upper_cols.size(); ++i) {
+    upper_val[i] = colUB[upper_cols[i]];
+    model->solver()->setColUpper(upper_cols[i], upper_val[i]);
+  }
+  model->invalidateRelaxedRowInf();
+  desc->tightenVarSoftBound(lower_cols.size(),
+                            lower_cols.empty() ? NULL : &lower_cols[0],
+                            lower_cols.empty() ? NULL : &lower_val[0],
+                            upper_cols.size(),
+                            upper_cols.empty() ? NULL : &upper_cols[0],
+                            upper_cols.empty() ? NULL : &upper_val[0]);
+  // debug message
+  std::stringstream debug_msg;
+  debug_msg << "[" << broker()->getProcRank() << "] Propagation tightened "
+            << lower_cols.size() << " lower and " << upper_cols.size()
+            << " upper bounds of node " << getIndex() << ".";
+  message_handler->message(0, "Dco", debug_msg.str().c_str(),
+                           'G', DISCO_DLOG_PROCESS)
+    << CoinMessageEol;
+  return true;
+}
+
 /** This method must be invoked on a \c pregnant node (which has all the
     information needed to create the children) and should create the
     children's decriptions. The stati of the children
@@ -1573,14 +1934,9 @@ void DcoTreeNode::branchConstrainOrPrice(BcpsSubproblemStatus subproblem_status,
   if (numColsInf && numRowsInf) {
     // both relaxed columns and relaxed rows are infeasible
     //double cone_tol = model->dcoPar()->entry(DcoParams::coneTol);
-    double gap;
-    if (quality_<=-ALPS_OBJ_MAX ||
-        !broker()->hasKnowledge(AlpsKnowledgeTypeSolution)) {
-      // subproblem is not solved yet, or
-      // no incumbent solution in broker
-      gap = COIN_DBL_MAX;
-    }
-    else if (broker()->getIncumbentValue()<quality_) {
+    if (quality_>-ALPS_OBJ_MAX and
+        broker()->hasKnowledge(AlpsKnowledgeTypeSolution) and
+        broker()->getIncumbentValue()<quality_) {
       // this node should be fathomed
       keepBounding = false;
       branch = false;
@@ -1588,26 +1944,23 @@ void DcoTreeNode::branchConstrainOrPrice(BcpsSubproblemStatus subproblem_status,
       generateVariables = false;
       return;
     }
-    else {
-      gap = (broker()->getIncumbentValue() - quality_)/fabs(quality_);
-    }
 
     // Apply OA cut strategy, apply milp once OA is done.
 
     // OA cut generation strategy:
     // generate OA cuts for alpha many times after
-    // alpha iterations generate OA cuts only if the last improvement was
-    // larger than beta times current gap (i.e., we think we can get bound
-    // larger than current incumbent and fathom, so we invest) and total number
-    // of iteratios is less than gamma (we invested gamma iterations and could
-    // not fathom, so stop).
+    // alpha iterations generate OA cuts only if the cut loop does not tail
+    // off, i.e., the last rounds closed more than beta of the gap per round
+    // (we think we can get bound larger than current incumbent and fathom,
+    // so we invest) and they improved the bound faster than branching would,
+    // and total number of iteratios is less than gamma (we invested gamma
+    // iterations and could not fathom, so stop).
 
     // get parameters
     int alpha = model->dcoPar()->entry(DcoParams::cutOaAlpha);
     double beta = model->dcoPar()->entry(DcoParams::cutOaBeta);
     int gamma = model->dcoPar()->entry(DcoParams::cutOaGamma);
-    if (((bcpStats_.numBoundIter_<alpha)
-         or (bcpStats_.lastImp_>beta*gap)) and
+    if (((bcpStats_.numBoundIter_<alpha) or !tailingOff(beta)) and
         (bcpStats_.numBoundIter_<gamma)) {
       // std::cout << "node " << index_
       //           << " iter " << bcpStats_.numBoundIter_
@@ -1628,9 +1981,13 @@ void DcoTreeNode::branchConstrainOrPrice(BcpsSubproblemStatus subproblem_status,
       // invoke checking model->cutGenerationFrequency_
       int freq = model->cutGenerationFrequency();
       double delta = model->dcoPar()->entry(DcoParams::cutMilpDelta);
+      // delta keeps its relative meaning, the last round must improve the
+      // bound by more than delta times the objective value. Rounds must
+      // also beat branching, tailingOff() with no gap share checks that.
       if (bcpStats_.numMilpIter_ == 0 or
           (model->numConGenerators() > 1 and index_ % freq == 0
-           and bcpStats_.lastImp_/bcpStats_.lastObjVal_ > delta)) {
+           and bcpStats_.lastImp_/bcpStats_.lastObjVal_ > delta
+           and !tailingOff(0.0))) {
         // generate MILP
         keepBounding = true;
         branch = false;
@@ -1656,7 +2013,8 @@ void DcoTreeNode::branchConstrainOrPrice(BcpsSubproblemStatus subproblem_status,
     double delta = model->dcoPar()->entry(DcoParams::cutMilpDelta);
     if (bcpStats_.numMilpIter_ == 0 or
         (model->numConGenerators() > 1 and index_%freq == 0
-         and bcpStats_.lastImp_/bcpStats_.lastObjVal_ > delta)) {
+         and bcpStats_.lastImp_/bcpStats_.lastObjVal_ > delta
+         and !tailingOff(0.0))) {
       // generate MILP
       keepBounding = true;
       branch = false;
@@ -1684,18 +2042,10 @@ void DcoTreeNode::branchConstrainOrPrice(BcpsSubproblemStatus subproblem_status,
   }
   else if (sol) {
     // all relaxed cols and rows are feasible
+    sol = model->polishCandidate(sol);
     sol->setDepth(depth_);
-    //todo(aykut) solution has an index field I beleive that should be filled
-    //in Alps level.
-    sol->setIndex(broker()->getNumKnowledges(AlpsKnowledgeTypeSolution));
-    // Store in Alps pool
-    broker()->addKnowledge(AlpsKnowledgeTypeSolution,
-                           sol,
-                           model->objSense() * sol->getQuality());
-    // update solver with the new incumbent if better
-    double incum_val = broker()->getIncumbentValue();
-    model->solver()->setDblParam(OsiDualObjectiveLimit,
-                                 model->objSense()*incum_val);
+    // Store in Alps pool, broker owns sol after this point.
+    model->storeSolution(sol, "node");
     // set node status to fathomed.
     message_handler->message(0, "Dco", "Node is feasible, fathoming... ",
                              'G', DISCO_DLOG_BRANCH)
@@ -1730,6 +2080,33 @@ void DcoTreeNode::branchConstrainOrPrice(BcpsSubproblemStatus subproblem_status,
   }
 }
 
+bool DcoTreeNode::tailingOff(double minGapShare) const {
+  if (bcpStats_.roundImp_.empty()) {
+    return false;
+  }
+  DcoModel * model = dynamic_cast<DcoModel*>(broker()->getModel());
+  int num_rounds = bcpStats_.roundImp_.size();
+  double imp = std::accumulate(bcpStats_.roundImp_.begin(),
+                               bcpStats_.roundImp_.end(), 0.0);
+  double time = std::accumulate(bcpStats_.roundTime_.begin(),
+                                bcpStats_.roundTime_.end(), 0.0);
+  // gap to close, objective magnitude (at least 1) when there is no
+  // incumbent.
+  double gap = CoinMax(1.0, fabs(quality_));
+  if (broker()->hasKnowledge(AlpsKnowledgeTypeSolution)) {
+    gap = broker()->getIncumbentValue() - quality_;
+  }
+  if (imp/num_rounds <= minGapShare*gap) {
+    return true;
+  }
+  // branching gives more per second
+  double branch_rate = model->branchRate();
+  if (branch_rate>0.0 and imp<branch_rate*time) {
+    return true;
+  }
+  return false;
+}
+
 //todo(aykut) replace this with DcoModel::feasibleSolution????
 void DcoTreeNode::checkRelaxedCols(int & numInf) {
   DcoModel * model = dynamic_cast<DcoModel*>(broker()->getModel());
@@ -2010,6 +2387,7 @@ void DcoTreeNode::applyConstraints(BcpsConstraintPool const * conPool) {
     bcpStats_.numLastCuts_ = num_add;
     // apply cuts
     model->solver()->applyRowCuts(num_add, cuts_to_add);
+    model->invalidateRelaxedRowInf();
     ws->resize(num_solver_rows + num_add, num_solver_cols);
     for (int i=0; i<num_add; ++i) {
       ws->setArtifStatus(num_solver_rows + i,
@@ -2113,6 +2491,7 @@ AlpsReturnStatus DcoTreeNode::decodeToSelf(AlpsEncoded & encoded) {
   bcpStats_.lastObjVal_ = 0.0;
   bcpStats_.startObjVal_ = 0.0;
   bcpStats_.numMilpIter_ = 0;
+  bcpStats_.roundStart_ = -1.0;
   bcpStats_.inactive_.clear();
   bcpStats_.generatorIndex_.clear();
   return status;
@@ -232,6 +232,17 @@ class DcoTreeNode: public BcpsTreeNode {
     // model()->conGenerators()[generatorIndex_[i]] is the generator of the cut
     // sitting at index i.
     std::list<int> generatorIndex_;
+    // generators called in the last round and their number of used cuts
+    // before the round. The bound improvement of the next bounding is
+    // credited to them in proportion to the cuts they got used.
+    std::vector<DcoConGenerator*> lastGens_;
+    std::vector<int> lastUsed_;
+    // bound improvement and wall clock time of the last cut rounds, at most
+    // cutTailOffRounds of them, oldest first.
+    std::list<double> roundImp_;
+    std::list<double> roundTime_;
+    // time the pending cut round started, negative if there is none.
+    double roundStart_;
   };
   BcpStats bcpStats_;
   /// Decide whether the given cut generator should be used, based on the cut
@@ -246,10 +257,26 @@ class DcoTreeNode: public BcpsTreeNode {
   /// status.
   void afterBound(DcoSubproblemStatus subproblem_status);
   int boundingLoop(bool isRoot, bool rampUp);
+  /// Propagate the bounds installed by installSubProblem() and tighten the
+  /// solver bounds and the soft bounds of this node. Fathoms the node and
+  /// returns false if they are infeasible.
+  bool propagateBounds();
+  /// Tighten column bounds using the reduced costs of the subproblem
+  /// solution and the incumbent value. Bounds found at the root are global,
+  /// they are written to the variables. Bounds found at other nodes are
+  /// kept as soft bounds of the node.
+  void reducedCostFixing();
   /// find number of infeasible integer variables.
   void checkRelaxedCols(int & numInf);
   /// update cut stats and clean in necessary
   void checkCuts();
+  /// Credit the bound improvement of the last bounding to the generators
+  /// called in the last round and adapt their scheduling.
+  void creditCutGenerators();
+  /// Returns true if the cut loop tails off. It does when the last cut rounds
+  /// close less than minGapShare of the gap per round, or when they improve
+  /// the bound slower per second than branching does.
+  bool tailingOff(double minGapShare) const;
  public:
   ///@name Constructors and Destructors
   //@{
@@ -308,6 +335,12 @@ class DcoTreeNode: public BcpsTreeNode {
   virtual BcpsSubproblemStatus bound();
   /// Call heuristics to search for solutions.
   virtual void callHeuristics();
+  /// Drain the solutions found by the heuristic thread, see
+  /// #DcoHeurExecutor.
+  void collectHeuristicSolutions();
+  /// Store solution found by a heuristic in the broker, at the depth of
+  /// this node.
+  void storeHeuristicSolution(DcoHeuristic const * heur, DcoSolution * sol);
   /// Apply given constraints
   virtual void applyConstraints(BcpsConstraintPool const * conPool);
   //@}